@@ -0,0 +1,285 @@
+#pragma once
+
+#include "lists/DynamicArray.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+
+/**
+ * @brief Epoch based memory reclamation for lock-free data structures.
+ * A thread pins itself (with a Guard) while it reads shared nodes. A node that was unlinked
+ * is retired, and it is deleted only after every thread that could still see it has unpinned:
+ * the global epoch advances only when all the pinned threads saw it, and a node retired in
+ * epoch e is deleted once the global epoch reaches e + 2.
+ * There is one reclaimer for the whole process, shared by all the structures that use it.
+*/
+class EpochReclaimer
+{
+public:
+	/**
+	 * @brief pins the current thread for its lifetime, guards may be nested.
+	*/
+	class Guard
+	{
+	public:
+		Guard()
+		{
+			EpochReclaimer::instance().pin();
+		}
+
+		~Guard()
+		{
+			EpochReclaimer::instance().unpin();
+		}
+
+		Guard(const Guard& other) = delete;
+
+		Guard& operator=(const Guard& other) = delete;
+	};
+
+	/**
+	 * @brief get the reclaimer of the process.
+	*/
+	static EpochReclaimer& instance()
+	{
+		static EpochReclaimer reclaimer;
+
+		return reclaimer;
+	}
+
+	/**
+	 * @brief delete an unlinked object once no pinned thread can reach it.
+	 * @param object
+	 * @param deleter the function that deletes the object.
+	 * @note that the object must already be unreachable for threads that pin from now on.
+	*/
+	void retire(void* object, void (*deleter)(void*))
+	{
+		ThreadState& state = threadState();
+
+		state.retired.add(Retired(object, deleter, globalEpoch_.load()));
+
+		if (state.retired.size() >= COLLECT_THRESHOLD)
+		{
+			collect(state);
+		}
+	}
+
+	/**
+	 * @brief advance the epoch if possible and delete what is safe to delete.
+	*/
+	void collect()
+	{
+		collect(threadState());
+	}
+
+private:
+	static const int MAX_THREADS = 256;
+	static const int COLLECT_THRESHOLD = 64;
+
+	/** An object waiting for deletion, with the epoch it was retired in. */
+	struct Retired
+	{
+		void* object;
+		void (*deleter)(void*);
+		uint64_t epoch;
+
+		Retired()
+		{
+			object = nullptr;
+			deleter = nullptr;
+			epoch = 0;
+		}
+
+		Retired(void* o, void (*d)(void*), uint64_t e)
+		{
+			object = o;
+			deleter = d;
+			epoch = e;
+		}
+
+		bool operator==(const Retired& other) const
+		{
+			return object == other.object;
+		}
+
+		bool operator!=(const Retired& other) const
+		{
+			return object != other.object;
+		}
+	};
+
+	/** The epoch a thread is pinned in (shifted left, the lowest bit marks a pinned thread). */
+	struct alignas(64) Slot
+	{
+		std::atomic<uint64_t> epoch;
+		std::atomic<bool> used;
+	};
+
+	/** The per thread part: its slot, its pin depth and the objects it retired. */
+	struct ThreadState
+	{
+		int slot;
+		int pins;
+		DynamicArray<Retired> retired;
+
+		ThreadState()
+		{
+			slot = EpochReclaimer::instance().acquireSlot();
+			pins = 0;
+		}
+
+		~ThreadState()
+		{
+			EpochReclaimer::instance().releaseThread(*this);
+		}
+	};
+
+	std::atomic<uint64_t> globalEpoch_;
+	Slot slots_[MAX_THREADS];
+
+	// objects left by threads that exited, deleted by the threads that collect later
+	std::mutex orphansLock_;
+	DynamicArray<Retired> orphans_;
+
+	EpochReclaimer()
+	{
+		globalEpoch_.store(0);
+
+		for (int i = 0; i < MAX_THREADS; i++)
+		{
+			slots_[i].epoch.store(0);
+			slots_[i].used.store(false);
+		}
+	}
+
+	~EpochReclaimer()
+	{
+		// no thread runs anymore, everything can go
+		for (int i = 0; i < orphans_.size(); i++)
+		{
+			orphans_[i].deleter(orphans_[i].object);
+		}
+	}
+
+	static ThreadState& threadState()
+	{
+		static thread_local ThreadState state;
+
+		return state;
+	}
+
+	int acquireSlot()
+	{
+		for (int i = 0; i < MAX_THREADS; i++)
+		{
+			bool expected = false;
+
+			if (!slots_[i].used.load() && slots_[i].used.compare_exchange_strong(expected, true))
+			{
+				return i;
+			}
+		}
+
+		throw std::overflow_error("too many threads use the epoch reclaimer");
+	}
+
+	void releaseThread(ThreadState& state)
+	{
+		collect(state);
+
+		{
+			std::lock_guard<std::mutex> lock(orphansLock_);
+
+			for (int i = 0; i < state.retired.size(); i++)
+			{
+				orphans_.add(state.retired[i]);
+			}
+		}
+
+		slots_[state.slot].epoch.store(0);
+		slots_[state.slot].used.store(false);
+	}
+
+	void pin()
+	{
+		ThreadState& state = threadState();
+
+		if (state.pins++ == 0)
+		{
+			// announce the epoch before reading any node (sequentially consistent, so the
+			// advancing thread sees it or this thread sees the newer epoch)
+			slots_[state.slot].epoch.store((globalEpoch_.load() << 1) | 1);
+		}
+	}
+
+	void unpin()
+	{
+		ThreadState& state = threadState();
+
+		if (--state.pins == 0)
+		{
+			slots_[state.slot].epoch.store(0, std::memory_order_release);
+		}
+	}
+
+	/**
+	 * @brief advance the global epoch if all the pinned threads are in it.
+	*/
+	void tryAdvance()
+	{
+		uint64_t epoch = globalEpoch_.load();
+
+		for (int i = 0; i < MAX_THREADS; i++)
+		{
+			uint64_t slotEpoch = slots_[i].epoch.load();
+
+			if ((slotEpoch & 1) && (slotEpoch >> 1) != epoch)
+			{
+				return;
+			}
+		}
+
+		globalEpoch_.compare_exchange_strong(epoch, epoch + 1);
+	}
+
+	/**
+	 * @brief delete the objects retired at least two epochs ago, keep the others.
+	*/
+	void release(DynamicArray<Retired>& retired)
+	{
+		uint64_t epoch = globalEpoch_.load();
+		int kept = 0;
+
+		for (int i = 0; i < retired.size(); i++)
+		{
+			if (retired[i].epoch + 2 <= epoch)
+			{
+				retired[i].deleter(retired[i].object);
+			}
+			else
+			{
+				retired[kept++] = retired[i];
+			}
+		}
+
+		while (retired.size() > kept)
+		{
+			retired.removeLast();
+		}
+	}
+
+	void collect(ThreadState& state)
+	{
+		tryAdvance();
+		release(state.retired);
+
+		std::unique_lock<std::mutex> lock(orphansLock_, std::try_to_lock);
+
+		if (lock.owns_lock())
+		{
+			release(orphans_);
+		}
+	}
+};
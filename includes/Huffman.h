@@ -50,7 +50,7 @@ public:
 			freq = f;
 		}
 
-		bool operator<(HuffmanPair& other)
+		bool operator<(const HuffmanPair& other) const
 		{
 			if (!init)
 			{
@@ -65,7 +65,7 @@ public:
 			return freq < other.freq;
 		}
 
-		bool operator>(HuffmanPair& other)
+		bool operator>(const HuffmanPair& other) const
 		{
 			if (!init)
 			{
@@ -80,7 +80,7 @@ public:
 			return freq > other.freq;
 		}
 
-		bool operator<=(HuffmanPair& other)
+		bool operator<=(const HuffmanPair& other) const
 		{
 			if (!init)
 			{
@@ -95,7 +95,7 @@ public:
 			return freq <= other.freq;
 		}
 
-		bool operator>=(HuffmanPair& other)
+		bool operator>=(const HuffmanPair& other) const
 		{
 			if (!init)
 			{
@@ -110,7 +110,7 @@ public:
 			return freq >= other.freq;
 		}
 
-		bool operator==(HuffmanPair& other)
+		bool operator==(const HuffmanPair& other) const
 		{
 			if (!init)
 			{
@@ -125,7 +125,7 @@ public:
 			return freq == other.freq;
 		}
 
-		bool operator!=(HuffmanPair& other)
+		bool operator!=(const HuffmanPair& other) const
 		{
 			if (!init)
 			{
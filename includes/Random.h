@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+/**
+ * @brief A small and fast pseudo random generator (xoshiro256**), seeded through splitmix64.
+ * It is not cryptographically secure, it is meant for randomized data structures.
+*/
+class FastRandom
+{
+public:
+	/**
+	 * @brief create a generator with a seed taken from std::random_device.
+	*/
+	FastRandom()
+	{
+		std::random_device rnd;
+
+		seed(((uint64_t)rnd() << 32) ^ rnd());
+	}
+
+	/**
+	 * @brief create a generator with a given seed, the same seed gives the same sequence.
+	 * @param s
+	*/
+	explicit FastRandom(uint64_t s)
+	{
+		seed(s);
+	}
+
+	/**
+	 * @brief restart the sequence from a given seed.
+	 * @param s
+	*/
+	void seed(uint64_t s)
+	{
+		// splitmix64 spreads the seed over the whole state, which must not be all zeros
+		for (int i = 0; i < 4; i++)
+		{
+			s += 0x9e3779b97f4a7c15ULL;
+
+			uint64_t z = s;
+
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+			state_[i] = z ^ (z >> 31);
+		}
+	}
+
+	/**
+	 * @brief get the next random 64 bit word.
+	*/
+	uint64_t next()
+	{
+		uint64_t result = rotl(state_[1] * 5, 7) * 9;
+		uint64_t t = state_[1] << 17;
+
+		state_[2] ^= state_[0];
+		state_[3] ^= state_[1];
+		state_[1] ^= state_[2];
+		state_[0] ^= state_[3];
+
+		state_[2] ^= t;
+		state_[3] = rotl(state_[3], 45);
+
+		return result;
+	}
+
+	/**
+	 * @brief get a random number in [0, bound).
+	 * @param bound a positive number.
+	*/
+	uint64_t below(uint64_t bound)
+	{
+		return next() % bound;
+	}
+
+	/**
+	 * @brief count the trailing zero bits of a word (64 for zero).
+	 * @param x
+	 * @return the number of trailing zeros, a geometric variable with p = 1/2 for a random word.
+	*/
+	static int trailingZeros(uint64_t x)
+	{
+		if (x == 0)
+		{
+			return 64;
+		}
+
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctzll(x);
+#else
+		int count = 0;
+
+		while (!(x & 1))
+		{
+			x >>= 1;
+			count++;
+		}
+
+		return count;
+#endif
+	}
+
+private:
+	uint64_t state_[4];
+
+	static uint64_t rotl(uint64_t x, int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+};
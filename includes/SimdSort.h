@@ -0,0 +1,328 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_SORT_AVX2
+#define SIMD_SORT_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+/**
+ * AVX2 sorting kernels for 32 bit signed integers.
+ * A block of 64 keys is sorted in 8 registers: a sorting network sorts the 8 columns, a
+ * transpose turns them into 8 sorted rows, and bitonic merges (min/max and shuffles, without
+ * branches) merge the rows into 2, 4 and 8 register runs. Longer arrays are sorted block by
+ * block and the blocks are merged 8 keys at a time with the same bitonic merge.
+ * The kernels are compiled for AVX2 whatever the build flags are; call them only when
+ * supported() is true (checked at run time).
+ */
+class SimdSort
+{
+public:
+	static const int BLOCK = 64;
+
+	/**
+	 * @brief check if the CPU can run the kernels.
+	*/
+	static bool supported();
+
+	/**
+	 * @brief sort an array of keys.
+	 * @param keys
+	 * @param size a multiple of BLOCK.
+	 * @param buffer room for size keys.
+	*/
+	static void sort(int32_t* keys, int size, int32_t* buffer);
+
+#ifdef SIMD_SORT_AVX2
+private:
+	static const int LANES = 8;
+
+	SIMD_SORT_TARGET static void minMax(__m256i& a, __m256i& b);
+
+	SIMD_SORT_TARGET static void reverse(__m256i& v);
+
+	/**
+	 * @brief sort a bitonic register.
+	*/
+	SIMD_SORT_TARGET static void cleanRegister(__m256i& v);
+
+	/**
+	 * @brief sort a bitonic sequence of count registers.
+	*/
+	SIMD_SORT_TARGET static void clean(__m256i* v, int count);
+
+	/**
+	 * @brief merge two sorted sequences of count registers, a gets the lower half.
+	*/
+	SIMD_SORT_TARGET static void merge(__m256i* a, __m256i* b, int count);
+
+	/**
+	 * @brief sort each lane across 8 registers with the 19 comparator network.
+	*/
+	SIMD_SORT_TARGET static void sortColumns(__m256i* r);
+
+	SIMD_SORT_TARGET static void transpose(__m256i* r);
+
+	/**
+	 * @brief sort 64 keys.
+	*/
+	SIMD_SORT_TARGET static void sortBlock(int32_t* keys);
+
+	/**
+	 * @brief merge two sorted runs whose lengths are multiples of 8 into out.
+	*/
+	SIMD_SORT_TARGET static void mergeRuns(const int32_t* a, int lengthA, const int32_t* b, int lengthB, int32_t* out);
+#endif
+};
+
+inline bool SimdSort::supported()
+{
+#ifdef SIMD_SORT_AVX2
+	static const bool avx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+
+	return avx2;
+#else
+	return false;
+#endif
+}
+
+#ifdef SIMD_SORT_AVX2
+
+SIMD_SORT_TARGET inline void SimdSort::sort(int32_t* keys, int size, int32_t* buffer)
+{
+	for (int i = 0; i < size; i += BLOCK)
+	{
+		sortBlock(keys + i);
+	}
+
+	// merge the runs in rounds, back and forth between the keys and the buffer
+	int32_t* from = keys, * to = buffer;
+
+	for (int width = BLOCK; width < size; width *= 2)
+	{
+		for (int i = 0; i < size; i += 2 * width)
+		{
+			if (i + width >= size)
+			{
+				memcpy(to + i, from + i, (size - i) * sizeof(int32_t));
+			}
+			else
+			{
+				int second = size - i - width < width ? size - i - width : width;
+
+				mergeRuns(from + i, width, from + i + width, second, to + i);
+			}
+		}
+
+		int32_t* tmp = from;
+		from = to;
+		to = tmp;
+	}
+
+	if (from != keys)
+	{
+		memcpy(keys, from, size * sizeof(int32_t));
+	}
+}
+
+// PRIVATES
+
+SIMD_SORT_TARGET inline void SimdSort::minMax(__m256i& a, __m256i& b)
+{
+	__m256i min = _mm256_min_epi32(a, b);
+
+	b = _mm256_max_epi32(a, b);
+	a = min;
+}
+
+SIMD_SORT_TARGET inline void SimdSort::reverse(__m256i& v)
+{
+	v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+SIMD_SORT_TARGET inline void SimdSort::cleanRegister(__m256i& v)
+{
+	// compare the lanes 4 apart, then 2 apart, then 1 apart; the higher lane of a pair takes the max.
+	__m256i swapped = _mm256_permute2x128_si256(v, v, 1);
+
+	v = _mm256_blend_epi32(_mm256_min_epi32(v, swapped), _mm256_max_epi32(v, swapped), 0xF0);
+
+	swapped = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+	v = _mm256_blend_epi32(_mm256_min_epi32(v, swapped), _mm256_max_epi32(v, swapped), 0xCC);
+
+	swapped = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+	v = _mm256_blend_epi32(_mm256_min_epi32(v, swapped), _mm256_max_epi32(v, swapped), 0xAA);
+}
+
+SIMD_SORT_TARGET inline void SimdSort::clean(__m256i* v, int count)
+{
+	for (int distance = count / 2; distance > 0; distance /= 2)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (!(i & distance))
+			{
+				minMax(v[i], v[i + distance]);
+			}
+		}
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		cleanRegister(v[i]);
+	}
+}
+
+SIMD_SORT_TARGET inline void SimdSort::merge(__m256i* a, __m256i* b, int count)
+{
+	// a followed by b reversed is bitonic
+	for (int i = 0; i < count; i++)
+	{
+		reverse(b[i]);
+	}
+
+	for (int i = 0; i < count / 2; i++)
+	{
+		__m256i tmp = b[i];
+
+		b[i] = b[count - 1 - i];
+		b[count - 1 - i] = tmp;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		minMax(a[i], b[i]);
+	}
+
+	clean(a, count);
+	clean(b, count);
+}
+
+SIMD_SORT_TARGET inline void SimdSort::sortColumns(__m256i* r)
+{
+	minMax(r[0], r[2]);
+	minMax(r[1], r[3]);
+	minMax(r[4], r[6]);
+	minMax(r[5], r[7]);
+
+	minMax(r[0], r[4]);
+	minMax(r[1], r[5]);
+	minMax(r[2], r[6]);
+	minMax(r[3], r[7]);
+
+	minMax(r[0], r[1]);
+	minMax(r[2], r[3]);
+	minMax(r[4], r[5]);
+	minMax(r[6], r[7]);
+
+	minMax(r[2], r[4]);
+	minMax(r[3], r[5]);
+
+	minMax(r[1], r[4]);
+	minMax(r[3], r[6]);
+
+	minMax(r[1], r[2]);
+	minMax(r[3], r[4]);
+	minMax(r[5], r[6]);
+}
+
+SIMD_SORT_TARGET inline void SimdSort::transpose(__m256i* r)
+{
+	__m256i t[8], u[8];
+
+	for (int i = 0; i < 8; i += 2)
+	{
+		t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+		t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+	}
+
+	for (int i = 0; i < 8; i += 4)
+	{
+		u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+		u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+		u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+		u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+	}
+
+	for (int i = 0; i < 4; i++)
+	{
+		r[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+		r[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+	}
+}
+
+SIMD_SORT_TARGET inline void SimdSort::sortBlock(int32_t* keys)
+{
+	__m256i r[8];
+
+	for (int i = 0; i < 8; i++)
+	{
+		r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i * LANES));
+	}
+
+	sortColumns(r);
+	transpose(r);
+
+	merge(r, r + 1, 1);
+	merge(r + 2, r + 3, 1);
+	merge(r + 4, r + 5, 1);
+	merge(r + 6, r + 7, 1);
+
+	merge(r, r + 2, 2);
+	merge(r + 4, r + 6, 2);
+
+	merge(r, r + 4, 4);
+
+	for (int i = 0; i < 8; i++)
+	{
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(keys + i * LANES), r[i]);
+	}
+}
+
+SIMD_SORT_TARGET inline void SimdSort::mergeRuns(const int32_t* a, int lengthA, const int32_t* b, int lengthB,
+	int32_t* out)
+{
+	const int32_t* aEnd = a + lengthA, * bEnd = b + lengthB;
+
+	// the higher 8 keys of the last merge, they are merged with the next 8 keys of the run
+	// whose next key is lower
+	__m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+	__m256i next;
+
+	a += LANES;
+
+	while (a < aEnd || b < bEnd)
+	{
+		if (b == bEnd || (a < aEnd && *a <= *b))
+		{
+			next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+			a += LANES;
+		}
+		else
+		{
+			next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+			b += LANES;
+		}
+
+		merge(&high, &next, 1);
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), high);
+		out += LANES;
+
+		high = next;
+	}
+
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), high);
+}
+
+#else
+
+inline void SimdSort::sort(int32_t*, int, int32_t*)
+{
+	// never called, supported() is false
+}
+
+#endif
@@ -1,6 +1,15 @@
 #pragma once
 
 #include "lists/DynamicArray.h"
+#include "Random.h"
+#include "SimdSort.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <utility>
 
 template <typename T>
 class Sort
@@ -17,6 +26,322 @@ public:
 	static void selectionSort(T* arr, int size);
 
 	static void selectionSort(DynamicArray<T>& arr);
+
+	/**
+	 * @brief sort an array in O(n log n) with a pattern-defeating quicksort (pdqsort).
+	 * the pivot is the median of 3 (or the median of 3 medians of 3 for large partitions),
+	 * small partitions are insertion-sorted, runs of equal keys are split off in one pass,
+	 * partitions that are already in order are detected and left as they are, and after
+	 * too many unbalanced partitions it falls back to heapsort.
+	 * arithmetic keys are partitioned in blocks, without branches that depend on the keys.
+	 * not stable.
+	 * @param arr
+	 * @param size
+	 * @param compare the order - compare(a, b) is true iff a comes before b.
+	*/
+	template<typename Compare = std::less<T> >
+	static void quickSort(T* arr, int size, Compare compare = Compare());
+
+	template<typename Compare = std::less<T> >
+	static void quickSort(DynamicArray<T>& arr, Compare compare = Compare());
+
+	/**
+	 * @brief sort an array on several threads with a parallel sample sort.
+	 * the keys are split into buckets by splitters picked from a random sample, each thread
+	 * classifies and scatters its own slice, then the threads take the buckets from a shared
+	 * counter (the largest first) and quickSort them. a key that shows up more than once among
+	 * the splitters gets a bucket of its own, which needs no sorting, so inputs with few distinct
+	 * keys do not end up in one large bucket. below PARALLEL_THRESHOLD keys, or with one thread,
+	 * it is a plain quickSort.
+	 * uses a buffer of size keys. not stable.
+	 * @param arr
+	 * @param size
+	 * @param threads the number of threads to use (0 for one per hardware thread).
+	 * @param compare
+	*/
+	template<typename Compare = std::less<T> >
+	static void parallelSort(T* arr, int size, int threads = 0, Compare compare = Compare());
+
+	template<typename Compare = std::less<T> >
+	static void parallelSort(DynamicArray<T>& arr, int threads = 0, Compare compare = Compare());
+
+	// smaller arrays are sorted on the calling thread
+	static const int PARALLEL_THRESHOLD = 1 << 16;
+
+	/**
+	 * @brief sort an array of integers or floating point numbers with an LSD radix sort,
+	 * in O(n) per 11 bit digit of the key: each pass scatters the keys by one digit, from the
+	 * lowest. the histograms of all the digits are counted in one pass, and the passes where all
+	 * the keys share the same digit are skipped. signed and floating point keys are mapped to
+	 * unsigned ones of the same order by flipping bits (NaNs go to the ends).
+	 * uses a buffer of size keys.
+	 * @param arr
+	 * @param size
+	*/
+	static void radixSort(T* arr, int size);
+
+	static void radixSort(DynamicArray<T>& arr);
+
+	/**
+	 * @brief sort records by an integer or floating point key with an LSD radix sort.
+	 * stable - records with equal keys stay in their order.
+	 * @param arr
+	 * @param size
+	 * @param keyOf gets the key of a record.
+	*/
+	template<typename KeyOf>
+	static void radixSort(T* arr, int size, KeyOf keyOf);
+
+	template<typename KeyOf>
+	static void radixSort(DynamicArray<T>& arr, KeyOf keyOf);
+
+	/**
+	 * @brief sort an array with a stable, adaptive merge sort (powersort).
+	 * the array is cut into its natural runs (descending runs are reversed, short runs are
+	 * extended by insertion sort), and the runs are merged in the order of the powersort
+	 * policy, which is nearly optimal for the run lengths - O(n) for a sorted array and
+	 * O(n log n) at worst. the merges gallop through long stretches taken from one run.
+	 * uses a buffer of size / 2 keys.
+	 * @param arr
+	 * @param size
+	 * @param compare
+	*/
+	template<typename Compare = std::less<T> >
+	static void mergeSort(T* arr, int size, Compare compare = Compare());
+
+	template<typename Compare = std::less<T> >
+	static void mergeSort(DynamicArray<T>& arr, Compare compare = Compare());
+
+	/**
+	 * @brief sort a small array in ascending order.
+	 * 32 bit integers and floats are sorted with AVX2 sorting networks and bitonic merges when
+	 * the CPU has AVX2 (see SimdSort), other keys and arrays of up to 12 keys with insertion sort.
+	 * quickSort uses it for its small partitions.
+	 * @param arr
+	 * @param size
+	*/
+	static void sortSmall(T* arr, int size);
+
+	static void sortSmall(DynamicArray<T>& arr);
+
+private:
+	// partitions smaller than this are insertion-sorted
+	static const int INSERTION_SORT_THRESHOLD = 24;
+
+	// partitions smaller than this are sorted by SimdSort, when it applies
+	static const int SIMD_SORT_THRESHOLD = SimdSort::BLOCK + 1;
+
+	// smaller arrays are insertion-sorted by sortSmall - the kernels sort a whole block of
+	// padded keys, which only pays off from this size
+	static const int SIMD_SORT_MIN = 13;
+
+	// the keys SimdSort can sort, mapped to 32 bit signed integers
+	static const bool SIMD_KEYS = std::is_arithmetic<T>::value && sizeof(T) == 4;
+
+	// partitions larger than this take the median of 3 medians of 3 as the pivot
+	static const int NINTHER_THRESHOLD = 128;
+
+	// the number of insertions partialInsertionSort makes before it gives up
+	static const int PARTIAL_INSERTION_SORT_LIMIT = 8;
+
+	// the number of keys the block partitioning classifies at a time
+	static const int BLOCK_SIZE = 64;
+
+	// the smallest slice worth a thread of its own in parallelSort
+	static const int MIN_SLICE = 1 << 14;
+
+	// parallelSort makes this many buckets per thread (at most MAX_BUCKETS), so the threads
+	// that finish early can take more of them. with equality buckets there are up to twice as
+	// many, and a bucket id has to fit in a byte.
+	static const int BUCKETS_PER_THREAD = 4;
+	static const int MAX_BUCKETS = 128;
+
+	// the sample size per bucket
+	static const int OVERSAMPLING = 32;
+
+	// smaller arrays are insertion-sorted by radixSort
+	static const int RADIX_THRESHOLD = 64;
+
+	// radixSort scatters by one digit per pass - 3 passes for 32 bit keys and 6 for 64 bit keys.
+	// the 2048 offsets of a pass (8 KB) stay in L1, and bytes would take a third more passes.
+	static const int RADIX_BITS = 11;
+	static const int RADIX = 1 << RADIX_BITS;
+
+	// mergeSort extends shorter runs to this length
+	static const int MIN_RUN = 32;
+
+	// the number of keys in a row a merge takes from one run before it starts galloping
+	static const int MIN_GALLOP = 7;
+
+	// the runs on the stack of mergeSort have increasing powers, which are at most 64
+	static const int MAX_RUNS = 66;
+
+	static int log2(int n);
+
+	/**
+	 * @brief the loop of quickSort on [begin, end).
+	 * @tparam Simd true iff the keys and the order are ones SimdSort can sort, so that the code of
+	 * the SIMD path (which compares with operator<) is only compiled for them.
+	 * @param badAllowed the number of unbalanced partitions left before switching to heapsort.
+	 * @param leftmost false iff the key before begin is not greater than any key in the range.
+	 * @param simd true iff Simd and the CPU can run SimdSort.
+	*/
+	template<typename Compare, bool Branchless, bool Simd>
+	static void quickSortLoop(T* begin, T* end, Compare& compare, int badAllowed, bool leftmost, bool simd);
+
+	static void sortSmall(T* arr, int size, std::true_type simdKeys);
+
+	static void sortSmall(T* arr, int size, std::false_type simdKeys);
+
+	/**
+	 * @brief the SIMD path of quickSortLoop, which never runs for other keys or orders.
+	*/
+	static void simdSortSmall(T* arr, int size, std::true_type simd);
+
+	static void simdSortSmall(T* arr, int size, std::false_type simd);
+
+	/**
+	 * @brief map a key to a 32 bit signed integer of the same order, and back.
+	*/
+	template<typename K>
+	static typename std::enable_if<std::is_integral<K>::value, int32_t>::type toSimdKey(K key);
+
+	static int32_t toSimdKey(float key);
+
+	template<typename K>
+	static typename std::enable_if<std::is_integral<K>::value>::type fromSimdKey(int32_t key, K& out);
+
+	static void fromSimdKey(int32_t key, float& out);
+
+	template<typename Compare>
+	static void insertionSort(T* begin, T* end, Compare& compare);
+
+	/**
+	 * @brief insertion sort that relies on the key before begin to stop the shifts.
+	*/
+	template<typename Compare>
+	static void unguardedInsertionSort(T* begin, T* end, Compare& compare);
+
+	/**
+	 * @brief insertion sort that gives up after a few insertions.
+	 * @return true iff the range got sorted.
+	*/
+	template<typename Compare>
+	static bool partialInsertionSort(T* begin, T* end, Compare& compare);
+
+	template<typename Compare>
+	static void sort2(T* a, T* b, Compare& compare);
+
+	template<typename Compare>
+	static void sort3(T* a, T* b, T* c, Compare& compare);
+
+	/**
+	 * @brief partition around the pivot at begin, the keys equal to it go to the right.
+	 * @param alreadyPartitioned set to true iff no key had to move.
+	 * @return the new position of the pivot.
+	*/
+	template<typename Compare>
+	static T* partitionRight(T* begin, T* end, Compare& compare, bool& alreadyPartitioned);
+
+	/**
+	 * @brief partitionRight that classifies blocks of keys into offset arrays first,
+	 * then swaps the misplaced ones - the comparisons do not decide any branch.
+	*/
+	template<typename Compare>
+	static T* partitionRightBranchless(T* begin, T* end, Compare& compare, bool& alreadyPartitioned);
+
+	/**
+	 * @brief swap num pairs of misplaced keys, given by offsets from first and from last.
+	*/
+	static void swapOffsets(T* first, T* last, unsigned char* offsetsLeft, unsigned char* offsetsRight,
+		int num, bool useSwaps);
+
+	/**
+	 * @brief partition around the pivot at begin, the keys equal to it go to the left.
+	 * used when the pivot equals the key before begin, so the keys equal to it are done.
+	 * @return the new position of the pivot.
+	*/
+	template<typename Compare>
+	static T* partitionLeft(T* begin, T* end, Compare& compare);
+
+	template<typename Compare>
+	static void heapSort(T* begin, T* end, Compare& compare);
+
+	template<typename Compare>
+	static void siftDown(T* arr, int i, int size, Compare& compare);
+
+	/**
+	 * @brief run task(0), ..., task(threads - 1) on separate threads (task(0) on the calling one).
+	*/
+	template<typename Task>
+	static void runParallel(int threads, Task task);
+
+	/**
+	 * @brief get the bucket of a key: the number of splitters that do not come after it.
+	*/
+	template<typename Compare>
+	static int bucketOf(const T& key, const T* splitters, int count, Compare& compare);
+
+	/**
+	 * @brief map a key to an unsigned integer of the same order.
+	*/
+	template<typename K>
+	static typename std::enable_if<std::is_integral<K>::value, typename std::make_unsigned<K>::type>::type
+		toRadix(K key);
+
+	static uint32_t toRadix(float key);
+
+	static uint64_t toRadix(double key);
+
+	/**
+	 * @brief the LSD radix sort of radixSort, by the unsigned keys toRadix(keyOf(record)) of type U.
+	*/
+	template<typename U, typename KeyOf>
+	static void radixSortBy(T* arr, int size, KeyOf& keyOf);
+
+	/**
+	 * @brief get the length of the run at begin, reversing it if it is strictly descending.
+	*/
+	template<typename Compare>
+	static int findRun(T* begin, T* end, Compare& compare);
+
+	/**
+	 * @brief get the powersort power of the boundary between adjacent runs:
+	 * the depth of the boundary in a perfectly balanced merge tree of [0, size).
+	*/
+	static int nodePower(int begin, int length1, int length2, int size);
+
+	/**
+	 * @brief merge the sorted runs [lo, mid) and [mid, hi).
+	 * @param minGallop the adaptive threshold for galloping, kept between merges.
+	*/
+	template<typename Compare>
+	static void mergeRuns(T* arr, int lo, int mid, int hi, T* buffer, int& minGallop, Compare& compare);
+
+	/**
+	 * @brief merge [lo, mid) and [mid, hi) from the left, with the first run in the buffer.
+	*/
+	template<typename Compare>
+	static void mergeLow(T* arr, int lo, int mid, int hi, T* buffer, int& minGallop, Compare& compare);
+
+	/**
+	 * @brief merge [lo, mid) and [mid, hi) from the right, with the second run in the buffer.
+	*/
+	template<typename Compare>
+	static void mergeHigh(T* arr, int lo, int mid, int hi, T* buffer, int& minGallop, Compare& compare);
+
+	/**
+	 * @brief get the number of keys in a sorted range that come before key (OrEqual - or equal it),
+	 * with an exponential search from hint followed by a binary search.
+	*/
+	template<bool OrEqual, typename Compare>
+	static int gallop(const T& key, const T* base, int n, int hint, Compare& compare);
+
+	/**
+	 * @brief check if x comes before key (OrEqual - or equals it).
+	*/
+	template<bool OrEqual, typename Compare>
+	static bool comesBefore(const T& x, const T& key, Compare& compare);
 };
 
 template<typename T>
@@ -100,3 +425,1393 @@ inline void Sort<T>::selectionSort(DynamicArray<T>& arr)
 {
 	selectionSort(arr.array_, arr.size());
 }
+
+template<typename T>
+template<typename Compare>
+inline void Sort<T>::quickSort(T* arr, int size, Compare compare)
+{
+	if (size < 2)
+	{
+		return;
+	}
+
+	// SimdSort sorts in the natural order only
+	const bool simdKeys = SIMD_KEYS && std::is_same<Compare, std::less<T> >::value;
+
+	quickSortLoop<Compare, std::is_arithmetic<T>::value, simdKeys>(arr, arr + size, compare, log2(size), true,
+		simdKeys && SimdSort::supported());
+}
+
+template<typename T>
+template<typename Compare>
+inline void Sort<T>::quickSort(DynamicArray<T>& arr, Compare compare)
+{
+	quickSort(arr.array_, arr.size(), compare);
+}
+
+template<typename T>
+template<typename Compare>
+void Sort<T>::parallelSort(T* arr, int size, int threads, Compare compare)
+{
+	if (threads <= 0)
+	{
+		threads = (int)std::thread::hardware_concurrency();
+	}
+
+	if (threads > size / MIN_SLICE)
+	{
+		threads = size / MIN_SLICE;
+	}
+
+	if (size < PARALLEL_THRESHOLD || threads <= 1)
+	{
+		quickSort(arr, size, compare);
+		return;
+	}
+
+	int buckets = threads * BUCKETS_PER_THREAD < MAX_BUCKETS ? threads * BUCKETS_PER_THREAD : MAX_BUCKETS;
+
+	// pick the splitters from a sorted random sample
+	int sampleSize = buckets * OVERSAMPLING;
+	T* sample = new T[sampleSize];
+	FastRandom random(size);
+
+	for (int i = 0; i < sampleSize; i++)
+	{
+		sample[i] = arr[random.below(size)];
+	}
+
+	quickSort(sample, sampleSize, compare);
+
+	// the distinct splitters - if some of them were equal, the keys equal to a splitter go to
+	// an equality bucket of their own: bucket 2b holds the keys between splitters b - 1 and b,
+	// and bucket 2b + 1 the keys equal to splitter b
+	T* splitters = new T[buckets - 1];
+	int splitterCount = 0;
+
+	for (int i = 0; i < buckets - 1; i++)
+	{
+		T& candidate = sample[(i + 1) * OVERSAMPLING];
+
+		if (splitterCount == 0 || compare(splitters[splitterCount - 1], candidate))
+		{
+			splitters[splitterCount++] = std::move(candidate);
+		}
+	}
+
+	delete[] sample;
+
+	bool equality = splitterCount < buckets - 1;
+
+	buckets = equality ? 2 * splitterCount + 1 : splitterCount + 1;
+
+	// counts[t * buckets + b] is the number of keys of bucket b in slice t (later its offset)
+	unsigned char* ids = new unsigned char[size];
+	int* counts = new int[threads * buckets]();
+
+	runParallel(threads, [&](int t)
+	{
+		int begin = (int)((long long)size * t / threads), end = (int)((long long)size * (t + 1) / threads);
+		int* count = counts + t * buckets;
+
+		for (int i = begin; i < end; i++)
+		{
+			int b = bucketOf(arr[i], splitters, splitterCount, compare);
+
+			if (equality)
+			{
+				// the key is not before splitter b - 1, it is equal to it unless it comes after it
+				b = b > 0 && !compare(splitters[b - 1], arr[i]) ? 2 * b - 1 : 2 * b;
+			}
+
+			ids[i] = (unsigned char)b;
+			count[b]++;
+		}
+	});
+
+	// the buckets are laid out one after the other, and each bucket by slices
+	int* starts = new int[buckets + 1];
+	int offset = 0;
+
+	for (int b = 0; b < buckets; b++)
+	{
+		starts[b] = offset;
+
+		for (int t = 0; t < threads; t++)
+		{
+			int count = counts[t * buckets + b];
+
+			counts[t * buckets + b] = offset;
+			offset += count;
+		}
+	}
+
+	starts[buckets] = size;
+
+	T* buffer = new T[size];
+
+	runParallel(threads, [&](int t)
+	{
+		int begin = (int)((long long)size * t / threads), end = (int)((long long)size * (t + 1) / threads);
+		int* next = counts + t * buckets;
+
+		for (int i = begin; i < end; i++)
+		{
+			buffer[next[ids[i]]++] = std::move(arr[i]);
+		}
+	});
+
+	// the largest buckets go first, so that no thread is left with a large one at the end
+	int* order = new int[buckets];
+
+	for (int b = 0; b < buckets; b++)
+	{
+		order[b] = b;
+	}
+
+	Sort<int>::quickSort(order, buckets, [starts](int a, int b)
+	{
+		return starts[a + 1] - starts[a] > starts[b + 1] - starts[b];
+	});
+
+	std::atomic<int> nextBucket(0);
+
+	runParallel(threads, [&](int)
+	{
+		for (int i = nextBucket++; i < buckets; i = nextBucket++)
+		{
+			int b = order[i];
+
+			// the keys of an equality bucket are all equal
+			if (!equality || b % 2 == 0)
+			{
+				quickSort(buffer + starts[b], starts[b + 1] - starts[b], compare);
+			}
+
+			for (int j = starts[b]; j < starts[b + 1]; j++)
+			{
+				arr[j] = std::move(buffer[j]);
+			}
+		}
+	});
+
+	delete[] order;
+	delete[] buffer;
+	delete[] starts;
+	delete[] counts;
+	delete[] ids;
+	delete[] splitters;
+}
+
+template<typename T>
+template<typename Compare>
+inline void Sort<T>::parallelSort(DynamicArray<T>& arr, int threads, Compare compare)
+{
+	parallelSort(arr.array_, arr.size(), threads, compare);
+}
+
+template<typename T>
+inline void Sort<T>::radixSort(T* arr, int size)
+{
+	radixSort(arr, size, [](const T& key) { return key; });
+}
+
+template<typename T>
+inline void Sort<T>::radixSort(DynamicArray<T>& arr)
+{
+	radixSort(arr.array_, arr.size());
+}
+
+template<typename T>
+template<typename KeyOf>
+inline void Sort<T>::radixSort(T* arr, int size, KeyOf keyOf)
+{
+	typedef decltype(toRadix(keyOf(*arr))) U;
+
+	radixSortBy<U>(arr, size, keyOf);
+}
+
+template<typename T>
+template<typename KeyOf>
+inline void Sort<T>::radixSort(DynamicArray<T>& arr, KeyOf keyOf)
+{
+	radixSort(arr.array_, arr.size(), keyOf);
+}
+
+template<typename T>
+template<typename Compare>
+void Sort<T>::mergeSort(T* arr, int size, Compare compare)
+{
+	if (size < MIN_RUN)
+	{
+		insertionSort(arr, arr + size, compare);
+		return;
+	}
+
+	T* buffer = new T[size / 2 + 1];
+	int minGallop = MIN_GALLOP;
+
+	// the stack of runs waiting to be merged, powers[i] is the power of the boundary before run i
+	int begins[MAX_RUNS], lengths[MAX_RUNS], powers[MAX_RUNS];
+	int runs = 0;
+
+	for (int begin = 0; begin < size; )
+	{
+		int length = findRun(arr + begin, arr + size, compare);
+
+		if (length < MIN_RUN)
+		{
+			int end = size - begin < MIN_RUN ? size : begin + MIN_RUN;
+
+			insertionSort(arr + begin, arr + end, compare);
+			length = end - begin;
+		}
+
+		if (runs > 0)
+		{
+			int power = nodePower(begins[runs - 1], lengths[runs - 1], length, size);
+
+			// merge the runs below boundaries deeper than the new one
+			while (runs > 1 && powers[runs - 1] > power)
+			{
+				mergeRuns(arr, begins[runs - 2], begins[runs - 1], begins[runs - 1] + lengths[runs - 1], buffer,
+					minGallop, compare);
+
+				lengths[runs - 2] += lengths[runs - 1];
+				runs--;
+			}
+
+			powers[runs] = power;
+		}
+
+		begins[runs] = begin;
+		lengths[runs] = length;
+		runs++;
+
+		begin += length;
+	}
+
+	while (runs > 1)
+	{
+		mergeRuns(arr, begins[runs - 2], begins[runs - 1], size, buffer, minGallop, compare);
+
+		lengths[runs - 2] += lengths[runs - 1];
+		runs--;
+	}
+
+	delete[] buffer;
+}
+
+template<typename T>
+template<typename Compare>
+inline void Sort<T>::mergeSort(DynamicArray<T>& arr, Compare compare)
+{
+	mergeSort(arr.array_, arr.size(), compare);
+}
+
+template<typename T>
+inline void Sort<T>::sortSmall(T* arr, int size)
+{
+	sortSmall(arr, size, std::integral_constant<bool, SIMD_KEYS>());
+}
+
+template<typename T>
+inline void Sort<T>::sortSmall(DynamicArray<T>& arr)
+{
+	sortSmall(arr.array_, arr.size());
+}
+
+// PRIVATES
+
+template<typename T>
+inline int Sort<T>::log2(int n)
+{
+	int log = 0;
+
+	while (n >>= 1)
+	{
+		log++;
+	}
+
+	return log;
+}
+
+template<typename T>
+template<typename Compare, bool Branchless, bool Simd>
+void Sort<T>::quickSortLoop(T* begin, T* end, Compare& compare, int badAllowed, bool leftmost, bool simd)
+{
+	// recurse into the left partition and loop on the right one
+	while (true)
+	{
+		int size = (int)(end - begin);
+
+		if (simd && size < SIMD_SORT_THRESHOLD)
+		{
+			simdSortSmall(begin, size, std::integral_constant<bool, Simd>());
+			return;
+		}
+
+		if (size < INSERTION_SORT_THRESHOLD)
+		{
+			if (leftmost)
+			{
+				insertionSort(begin, end, compare);
+			}
+			else
+			{
+				unguardedInsertionSort(begin, end, compare);
+			}
+
+			return;
+		}
+
+		// move the pivot to begin
+		int half = size / 2;
+
+		if (size > NINTHER_THRESHOLD)
+		{
+			sort3(begin, begin + half, end - 1, compare);
+			sort3(begin + 1, begin + (half - 1), end - 2, compare);
+			sort3(begin + 2, begin + (half + 1), end - 3, compare);
+			sort3(begin + (half - 1), begin + half, begin + (half + 1), compare);
+			std::swap(*begin, *(begin + half));
+		}
+		else
+		{
+			sort3(begin + half, begin, end - 1, compare);
+		}
+
+		// the pivot equals the key before the range, so do the keys equal to it, put them aside
+		if (!leftmost && !compare(*(begin - 1), *begin))
+		{
+			begin = partitionLeft(begin, end, compare) + 1;
+			continue;
+		}
+
+		bool alreadyPartitioned = false;
+		T* pivot = Branchless ? partitionRightBranchless(begin, end, compare, alreadyPartitioned)
+			: partitionRight(begin, end, compare, alreadyPartitioned);
+
+		int leftSize = (int)(pivot - begin), rightSize = (int)(end - (pivot + 1));
+
+		if (leftSize < size / 8 || rightSize < size / 8)
+		{
+			if (--badAllowed == 0)
+			{
+				heapSort(begin, end, compare);
+				return;
+			}
+
+			// shuffle a few keys to break the pattern that made the pivot bad
+			if (leftSize >= INSERTION_SORT_THRESHOLD)
+			{
+				std::swap(begin[0], begin[leftSize / 4]);
+				std::swap(pivot[-1], pivot[-leftSize / 4]);
+
+				if (leftSize > NINTHER_THRESHOLD)
+				{
+					std::swap(begin[1], begin[leftSize / 4 + 1]);
+					std::swap(begin[2], begin[leftSize / 4 + 2]);
+					std::swap(pivot[-2], pivot[-(leftSize / 4 + 1)]);
+					std::swap(pivot[-3], pivot[-(leftSize / 4 + 2)]);
+				}
+			}
+
+			if (rightSize >= INSERTION_SORT_THRESHOLD)
+			{
+				std::swap(pivot[1], pivot[1 + rightSize / 4]);
+				std::swap(end[-1], end[-rightSize / 4]);
+
+				if (rightSize > NINTHER_THRESHOLD)
+				{
+					std::swap(pivot[2], pivot[2 + rightSize / 4]);
+					std::swap(pivot[3], pivot[3 + rightSize / 4]);
+					std::swap(end[-2], end[-(1 + rightSize / 4)]);
+					std::swap(end[-3], end[-(2 + rightSize / 4)]);
+				}
+			}
+		}
+		// a balanced partition that moved nothing - the range may be sorted already
+		else if (alreadyPartitioned && partialInsertionSort(begin, pivot, compare) &&
+			partialInsertionSort(pivot + 1, end, compare))
+		{
+			return;
+		}
+
+		quickSortLoop<Compare, Branchless, Simd>(begin, pivot, compare, badAllowed, leftmost, simd);
+
+		begin = pivot + 1;
+		leftmost = false;
+	}
+}
+
+template<typename T>
+template<typename Compare>
+void Sort<T>::insertionSort(T* begin, T* end, Compare& compare)
+{
+	if (begin == end)
+	{
+		return;
+	}
+
+	for (T* cur = begin + 1; cur != end; cur++)
+	{
+		T* sift = cur;
+		T* prev = cur - 1;
+
+		if (compare(*sift, *prev))
+		{
+			T tmp = std::move(*sift);
+
+			do
+			{
+				*sift-- = std::move(*prev);
+			} while (sift != begin && compare(tmp, *--prev));
+
+			*sift = std::move(tmp);
+		}
+	}
+}
+
+template<typename T>
+template<typename Compare>
+void Sort<T>::unguardedInsertionSort(T* begin, T* end, Compare& compare)
+{
+	if (begin == end)
+	{
+		return;
+	}
+
+	for (T* cur = begin + 1; cur != end; cur++)
+	{
+		T* sift = cur;
+		T* prev = cur - 1;
+
+		if (compare(*sift, *prev))
+		{
+			T tmp = std::move(*sift);
+
+			do
+			{
+				*sift-- = std::move(*prev);
+			} while (compare(tmp, *--prev));
+
+			*sift = std::move(tmp);
+		}
+	}
+}
+
+template<typename T>
+template<typename Compare>
+bool Sort<T>::partialInsertionSort(T* begin, T* end, Compare& compare)
+{
+	if (begin == end)
+	{
+		return true;
+	}
+
+	int moves = 0;
+
+	for (T* cur = begin + 1; cur != end; cur++)
+	{
+		T* sift = cur;
+		T* prev = cur - 1;
+
+		if (compare(*sift, *prev))
+		{
+			T tmp = std::move(*sift);
+
+			do
+			{
+				*sift-- = std::move(*prev);
+			} while (sift != begin && compare(tmp, *--prev));
+
+			*sift = std::move(tmp);
+			moves += (int)(cur - sift);
+		}
+
+		if (moves > PARTIAL_INSERTION_SORT_LIMIT)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename T>
+template<typename Compare>
+inline void Sort<T>::sort2(T* a, T* b, Compare& compare)
+{
+	if (compare(*b, *a))
+	{
+		std::swap(*a, *b);
+	}
+}
+
+template<typename T>
+template<typename Compare>
+inline void Sort<T>::sort3(T* a, T* b, T* c, Compare& compare)
+{
+	sort2(a, b, compare);
+	sort2(b, c, compare);
+	sort2(a, b, compare);
+}
+
+template<typename T>
+template<typename Compare>
+T* Sort<T>::partitionRight(T* begin, T* end, Compare& compare, bool& alreadyPartitioned)
+{
+	T pivot = std::move(*begin);
+	T* first = begin;
+	T* last = end;
+
+	// the median of 3 guarantees a key that is not smaller than the pivot
+	while (compare(*++first, pivot));
+
+	// there is no such guard on the left if nothing was skipped
+	if (first - 1 == begin)
+	{
+		while (first < last && !compare(*--last, pivot));
+	}
+	else
+	{
+		while (!compare(*--last, pivot));
+	}
+
+	alreadyPartitioned = first >= last;
+
+	while (first < last)
+	{
+		std::swap(*first, *last);
+
+		while (compare(*++first, pivot));
+		while (!compare(*--last, pivot));
+	}
+
+	T* pivotPos = first - 1;
+
+	*begin = std::move(*pivotPos);
+	*pivotPos = std::move(pivot);
+
+	return pivotPos;
+}
+
+template<typename T>
+template<typename Compare>
+T* Sort<T>::partitionRightBranchless(T* begin, T* end, Compare& compare, bool& alreadyPartitioned)
+{
+	T pivot = std::move(*begin);
+	T* first = begin;
+	T* last = end;
+
+	while (compare(*++first, pivot));
+
+	if (first - 1 == begin)
+	{
+		while (first < last && !compare(*--last, pivot));
+	}
+	else
+	{
+		while (!compare(*--last, pivot));
+	}
+
+	alreadyPartitioned = first >= last;
+
+	if (!alreadyPartitioned)
+	{
+		std::swap(*first, *last);
+		first++;
+
+		// the offsets of the misplaced keys of a block on the left (from leftBase)
+		// and of a block on the right (back from rightBase)
+		alignas(64) unsigned char offsetsLeft[BLOCK_SIZE];
+		alignas(64) unsigned char offsetsRight[BLOCK_SIZE];
+
+		T* leftBase = first;
+		T* rightBase = last;
+		int numLeft = 0, numRight = 0, startLeft = 0, startRight = 0;
+
+		while (first < last)
+		{
+			// refill the empty blocks, splitting the unknown keys between them
+			int unknown = (int)(last - first);
+			int leftSplit = numLeft == 0 ? (numRight == 0 ? unknown / 2 : unknown) : 0;
+			int rightSplit = numRight == 0 ? unknown - leftSplit : 0;
+
+			leftSplit = leftSplit < BLOCK_SIZE ? leftSplit : BLOCK_SIZE;
+			rightSplit = rightSplit < BLOCK_SIZE ? rightSplit : BLOCK_SIZE;
+
+			for (int i = 0; i < leftSplit; i++)
+			{
+				offsetsLeft[numLeft] = (unsigned char)i;
+				numLeft += !compare(*first, pivot);
+				first++;
+			}
+
+			for (int i = 1; i <= rightSplit; i++)
+			{
+				offsetsRight[numRight] = (unsigned char)i;
+				numRight += compare(*--last, pivot);
+			}
+
+			// swap as many pairs as both blocks have
+			int num = numLeft < numRight ? numLeft : numRight;
+
+			swapOffsets(leftBase, rightBase, offsetsLeft + startLeft, offsetsRight + startRight, num,
+				numLeft == numRight);
+
+			numLeft -= num;
+			numRight -= num;
+			startLeft += num;
+			startRight += num;
+
+			if (numLeft == 0)
+			{
+				startLeft = 0;
+				leftBase = first;
+			}
+
+			if (numRight == 0)
+			{
+				startRight = 0;
+				rightBase = last;
+			}
+		}
+
+		// one block may still hold misplaced keys, move them to the middle
+		if (numLeft)
+		{
+			unsigned char* offsets = offsetsLeft + startLeft;
+
+			while (numLeft--)
+			{
+				std::swap(*(leftBase + offsets[numLeft]), *--last);
+			}
+
+			first = last;
+		}
+
+		if (numRight)
+		{
+			unsigned char* offsets = offsetsRight + startRight;
+
+			while (numRight--)
+			{
+				std::swap(*(rightBase - offsets[numRight]), *first);
+				first++;
+			}
+		}
+	}
+
+	T* pivotPos = first - 1;
+
+	*begin = std::move(*pivotPos);
+	*pivotPos = std::move(pivot);
+
+	return pivotPos;
+}
+
+template<typename T>
+void Sort<T>::swapOffsets(T* first, T* last, unsigned char* offsetsLeft, unsigned char* offsetsRight,
+	int num, bool useSwaps)
+{
+	// plain swaps keep a descending input O(n), where all the keys are misplaced
+	if (useSwaps)
+	{
+		for (int i = 0; i < num; i++)
+		{
+			std::swap(*(first + offsetsLeft[i]), *(last - offsetsRight[i]));
+		}
+	}
+	// otherwise rotate the keys through one temporary, with half the moves
+	else if (num > 0)
+	{
+		T* left = first + offsetsLeft[0];
+		T* right = last - offsetsRight[0];
+		T tmp = std::move(*left);
+
+		*left = std::move(*right);
+
+		for (int i = 1; i < num; i++)
+		{
+			left = first + offsetsLeft[i];
+			*right = std::move(*left);
+			right = last - offsetsRight[i];
+			*left = std::move(*right);
+		}
+
+		*right = std::move(tmp);
+	}
+}
+
+template<typename T>
+template<typename Compare>
+T* Sort<T>::partitionLeft(T* begin, T* end, Compare& compare)
+{
+	T pivot = std::move(*begin);
+	T* first = begin;
+	T* last = end;
+
+	while (compare(pivot, *--last));
+
+	if (last + 1 == end)
+	{
+		while (first < last && !compare(pivot, *++first));
+	}
+	else
+	{
+		while (!compare(pivot, *++first));
+	}
+
+	while (first < last)
+	{
+		std::swap(*first, *last);
+
+		while (compare(pivot, *--last));
+		while (!compare(pivot, *++first));
+	}
+
+	T* pivotPos = last;
+
+	*begin = std::move(*pivotPos);
+	*pivotPos = std::move(pivot);
+
+	return pivotPos;
+}
+
+template<typename T>
+template<typename Compare>
+void Sort<T>::heapSort(T* begin, T* end, Compare& compare)
+{
+	int size = (int)(end - begin);
+
+	for (int i = size / 2 - 1; i >= 0; i--)
+	{
+		siftDown(begin, i, size, compare);
+	}
+
+	// move the last key by compare (the top) behind the heap, one at a time
+	for (int last = size - 1; last > 0; last--)
+	{
+		std::swap(begin[0], begin[last]);
+		siftDown(begin, 0, last, compare);
+	}
+}
+
+template<typename T>
+template<typename Compare>
+void Sort<T>::siftDown(T* arr, int i, int size, Compare& compare)
+{
+	T key = std::move(arr[i]);
+
+	while (2 * i + 1 < size)
+	{
+		int child = 2 * i + 1;
+
+		if (child + 1 < size && compare(arr[child], arr[child + 1]))
+		{
+			child++;
+		}
+
+		if (!compare(key, arr[child]))
+		{
+			break;
+		}
+
+		arr[i] = std::move(arr[child]);
+		i = child;
+	}
+
+	arr[i] = std::move(key);
+}
+
+template<typename T>
+template<typename Task>
+void Sort<T>::runParallel(int threads, Task task)
+{
+	std::thread* workers = new std::thread[threads - 1];
+
+	for (int t = 1; t < threads; t++)
+	{
+		workers[t - 1] = std::thread(task, t);
+	}
+
+	task(0);
+
+	for (int t = 1; t < threads; t++)
+	{
+		workers[t - 1].join();
+	}
+
+	delete[] workers;
+}
+
+template<typename T>
+template<typename Compare>
+inline int Sort<T>::bucketOf(const T& key, const T* splitters, int count, Compare& compare)
+{
+	int low = 0, high = count;
+
+	while (low < high)
+	{
+		int mid = (low + high) / 2;
+
+		if (compare(key, splitters[mid]))
+		{
+			high = mid;
+		}
+		else
+		{
+			low = mid + 1;
+		}
+	}
+
+	return low;
+}
+
+template<typename T>
+template<typename K>
+inline typename std::enable_if<std::is_integral<K>::value, typename std::make_unsigned<K>::type>::type
+	Sort<T>::toRadix(K key)
+{
+	typedef typename std::make_unsigned<K>::type U;
+
+	// flip the sign bit, so the negative keys come first
+	return std::is_signed<K>::value ? (U)key ^ ((U)1 << (sizeof(U) * 8 - 1)) : (U)key;
+}
+
+template<typename T>
+inline uint32_t Sort<T>::toRadix(float key)
+{
+	uint32_t bits;
+
+	memcpy(&bits, &key, sizeof(bits));
+
+	// negative keys: flip all the bits (a larger magnitude comes first), positive keys: flip the sign bit
+	return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+}
+
+template<typename T>
+inline uint64_t Sort<T>::toRadix(double key)
+{
+	uint64_t bits;
+
+	memcpy(&bits, &key, sizeof(bits));
+
+	return bits & 0x8000000000000000ull ? ~bits : bits | 0x8000000000000000ull;
+}
+
+template<typename T>
+template<typename U, typename KeyOf>
+void Sort<T>::radixSortBy(T* arr, int size, KeyOf& keyOf)
+{
+	if (size < RADIX_THRESHOLD)
+	{
+		// insertion sort is stable too
+		auto compare = [&keyOf](const T& a, const T& b) { return toRadix(keyOf(a)) < toRadix(keyOf(b)); };
+
+		insertionSort(arr, arr + size, compare);
+		return;
+	}
+
+	const int digits = ((int)sizeof(U) * 8 + RADIX_BITS - 1) / RADIX_BITS;
+
+	// counts[d * RADIX + v] is the number of keys whose digit d is v
+	int* counts = new int[digits * RADIX]();
+
+	for (int i = 0; i < size; i++)
+	{
+		U key = toRadix(keyOf(arr[i]));
+
+		for (int d = 0; d < digits; d++)
+		{
+			counts[d * RADIX + (int)((key >> (d * RADIX_BITS)) & (RADIX - 1))]++;
+		}
+	}
+
+	U first = toRadix(keyOf(arr[0]));
+	T* buffer = new T[size];
+	T* from = arr, * to = buffer;
+
+	for (int d = 0; d < digits; d++)
+	{
+		int shift = d * RADIX_BITS;
+		int* count = counts + d * RADIX;
+
+		// all the keys have the same digit, the pass would not move anything
+		if (count[(first >> shift) & (RADIX - 1)] == size)
+		{
+			continue;
+		}
+
+		// turn the counts into offsets
+		for (int v = 0, offset = 0; v < RADIX; v++)
+		{
+			int c = count[v];
+
+			count[v] = offset;
+			offset += c;
+		}
+
+		for (int i = 0; i < size; i++)
+		{
+			U key = toRadix(keyOf(from[i]));
+
+			to[count[(key >> shift) & (RADIX - 1)]++] = std::move(from[i]);
+		}
+
+		std::swap(from, to);
+	}
+
+	if (from != arr)
+	{
+		for (int i = 0; i < size; i++)
+		{
+			arr[i] = std::move(from[i]);
+		}
+	}
+
+	delete[] buffer;
+	delete[] counts;
+}
+
+template<typename T>
+template<typename Compare>
+int Sort<T>::findRun(T* begin, T* end, Compare& compare)
+{
+	T* last = begin + 1;
+
+	if (last == end)
+	{
+		return 1;
+	}
+
+	// strictly descending - reversing it keeps equal keys in order
+	if (compare(*last, *begin))
+	{
+		while (last + 1 != end && compare(*(last + 1), *last))
+		{
+			last++;
+		}
+
+		for (T* low = begin, * high = last; low < high; low++, high--)
+		{
+			std::swap(*low, *high);
+		}
+	}
+	else
+	{
+		while (last + 1 != end && !compare(*(last + 1), *last))
+		{
+			last++;
+		}
+	}
+
+	return (int)(last - begin) + 1;
+}
+
+template<typename T>
+int Sort<T>::nodePower(int begin, int length1, int length2, int size)
+{
+	// twice the midpoints of the runs, as fractions of size
+	long long a = 2LL * begin + length1, b = a + length1 + length2;
+	int power = 0;
+
+	// the power is the first bit where the binary fractions a / 2size and b / 2size differ
+	while (true)
+	{
+		power++;
+
+		if (a >= size)
+		{
+			a -= size;
+			b -= size;
+		}
+		else if (b >= size)
+		{
+			break;
+		}
+
+		a <<= 1;
+		b <<= 1;
+	}
+
+	return power;
+}
+
+template<typename T>
+template<typename Compare>
+void Sort<T>::mergeRuns(T* arr, int lo, int mid, int hi, T* buffer, int& minGallop, Compare& compare)
+{
+	// the keys of the first run that do not come after the second run's first key are in place
+	lo += gallop<true>(arr[mid], arr + lo, mid - lo, 0, compare);
+
+	if (lo == mid)
+	{
+		return;
+	}
+
+	// so are the keys of the second run that come after the first run's last key
+	hi = mid + gallop<false>(arr[mid - 1], arr + mid, hi - mid, hi - mid - 1, compare);
+
+	if (mid - lo <= hi - mid)
+	{
+		mergeLow(arr, lo, mid, hi, buffer, minGallop, compare);
+	}
+	else
+	{
+		mergeHigh(arr, lo, mid, hi, buffer, minGallop, compare);
+	}
+}
+
+template<typename T>
+template<typename Compare>
+void Sort<T>::mergeLow(T* arr, int lo, int mid, int hi, T* buffer, int& minGallop, Compare& compare)
+{
+	for (int i = lo; i < mid; i++)
+	{
+		buffer[i - lo] = std::move(arr[i]);
+	}
+
+	T* a = buffer, * aEnd = buffer + (mid - lo);
+	T* b = arr + mid, * bEnd = arr + hi;
+	T* dest = arr + lo;
+
+	while (a < aEnd && b < bEnd)
+	{
+		int countA = 0, countB = 0;
+
+		// one key at a time, until one run wins minGallop times in a row
+		while (a < aEnd && b < bEnd)
+		{
+			if (compare(*b, *a))
+			{
+				*dest++ = std::move(*b++);
+				countA = 0;
+
+				if (++countB >= minGallop)
+				{
+					break;
+				}
+			}
+			else
+			{
+				*dest++ = std::move(*a++);
+				countB = 0;
+
+				if (++countA >= minGallop)
+				{
+					break;
+				}
+			}
+		}
+
+		// gallop, as long as the runs keep winning long stretches
+		while (a < aEnd && b < bEnd)
+		{
+			countA = gallop<true>(*b, a, (int)(aEnd - a), 0, compare);
+
+			for (int i = 0; i < countA; i++)
+			{
+				*dest++ = std::move(*a++);
+			}
+
+			if (a == aEnd)
+			{
+				break;
+			}
+
+			*dest++ = std::move(*b++);
+
+			if (b == bEnd)
+			{
+				break;
+			}
+
+			countB = gallop<false>(*a, b, (int)(bEnd - b), 0, compare);
+
+			for (int i = 0; i < countB; i++)
+			{
+				*dest++ = std::move(*b++);
+			}
+
+			if (b == bEnd)
+			{
+				break;
+			}
+
+			*dest++ = std::move(*a++);
+
+			minGallop -= minGallop > 1 ? 1 : 0;
+
+			if (countA < MIN_GALLOP && countB < MIN_GALLOP)
+			{
+				// galloping does not pay off here, make it harder to start again
+				minGallop += 2;
+				break;
+			}
+		}
+	}
+
+	// the rest of the second run is already in place
+	while (a < aEnd)
+	{
+		*dest++ = std::move(*a++);
+	}
+}
+
+template<typename T>
+template<typename Compare>
+void Sort<T>::mergeHigh(T* arr, int lo, int mid, int hi, T* buffer, int& minGallop, Compare& compare)
+{
+	for (int i = mid; i < hi; i++)
+	{
+		buffer[i - mid] = std::move(arr[i]);
+	}
+
+	// a and b point after the last keys left in the runs
+	T* aBegin = arr + lo, * a = arr + mid;
+	T* bBegin = buffer, * b = buffer + (hi - mid);
+	T* dest = arr + hi;
+
+	while (a > aBegin && b > bBegin)
+	{
+		int countA = 0, countB = 0;
+
+		while (a > aBegin && b > bBegin)
+		{
+			if (compare(*(b - 1), *(a - 1)))
+			{
+				*--dest = std::move(*--a);
+				countB = 0;
+
+				if (++countA >= minGallop)
+				{
+					break;
+				}
+			}
+			else
+			{
+				*--dest = std::move(*--b);
+				countA = 0;
+
+				if (++countB >= minGallop)
+				{
+					break;
+				}
+			}
+		}
+
+		while (a > aBegin && b > bBegin)
+		{
+			// the keys of the first run that come after the second run's last key
+			int left = (int)(a - aBegin);
+
+			countA = left - gallop<true>(*(b - 1), aBegin, left, left - 1, compare);
+
+			for (int i = 0; i < countA; i++)
+			{
+				*--dest = std::move(*--a);
+			}
+
+			if (a == aBegin)
+			{
+				break;
+			}
+
+			*--dest = std::move(*--b);
+
+			if (b == bBegin)
+			{
+				break;
+			}
+
+			// the keys of the second run that do not come before the first run's last key
+			left = (int)(b - bBegin);
+			countB = left - gallop<false>(*(a - 1), bBegin, left, left - 1, compare);
+
+			for (int i = 0; i < countB; i++)
+			{
+				*--dest = std::move(*--b);
+			}
+
+			if (b == bBegin)
+			{
+				break;
+			}
+
+			*--dest = std::move(*--a);
+
+			minGallop -= minGallop > 1 ? 1 : 0;
+
+			if (countA < MIN_GALLOP && countB < MIN_GALLOP)
+			{
+				minGallop += 2;
+				break;
+			}
+		}
+	}
+
+	// the rest of the first run is already in place
+	while (b > bBegin)
+	{
+		*--dest = std::move(*--b);
+	}
+}
+
+template<typename T>
+template<bool OrEqual, typename Compare>
+int Sort<T>::gallop(const T& key, const T* base, int n, int hint, Compare& compare)
+{
+	if (n == 0)
+	{
+		return 0;
+	}
+
+	// the answer is in [low, high]
+	int low, high, last = 0, offset = 1;
+
+	if (comesBefore<OrEqual>(base[hint], key, compare))
+	{
+		int max = n - hint;
+
+		while (offset < max && comesBefore<OrEqual>(base[hint + offset], key, compare))
+		{
+			last = offset;
+			offset = offset < max / 2 ? 2 * offset + 1 : max;
+		}
+
+		offset = offset < max ? offset : max;
+		low = hint + last + 1;
+		high = hint + offset;
+	}
+	else
+	{
+		int max = hint + 1;
+
+		while (offset < max && !comesBefore<OrEqual>(base[hint - offset], key, compare))
+		{
+			last = offset;
+			offset = offset < max / 2 ? 2 * offset + 1 : max;
+		}
+
+		offset = offset < max ? offset : max;
+		low = hint - offset + 1;
+		high = hint - last;
+	}
+
+	while (low < high)
+	{
+		int mid = low + (high - low) / 2;
+
+		if (comesBefore<OrEqual>(base[mid], key, compare))
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+template<typename T>
+template<bool OrEqual, typename Compare>
+inline bool Sort<T>::comesBefore(const T& x, const T& key, Compare& compare)
+{
+	return OrEqual ? !compare(key, x) : compare(x, key);
+}
+
+template<typename T>
+void Sort<T>::sortSmall(T* arr, int size, std::true_type)
+{
+	if (size < SIMD_SORT_MIN || !SimdSort::supported())
+	{
+		sortSmall(arr, size, std::false_type());
+		return;
+	}
+
+	// the keys and a buffer, padded to whole blocks with the largest key
+	int padded = (size + SimdSort::BLOCK - 1) / SimdSort::BLOCK * SimdSort::BLOCK;
+	int32_t local[2 * SimdSort::BLOCK];
+	int32_t* keys = padded == SimdSort::BLOCK ? local : new int32_t[2 * padded];
+
+	for (int i = 0; i < size; i++)
+	{
+		keys[i] = toSimdKey(arr[i]);
+	}
+
+	for (int i = size; i < padded; i++)
+	{
+		keys[i] = INT32_MAX;
+	}
+
+	SimdSort::sort(keys, padded, keys + padded);
+
+	for (int i = 0; i < size; i++)
+	{
+		fromSimdKey(keys[i], arr[i]);
+	}
+
+	if (keys != local)
+	{
+		delete[] keys;
+	}
+}
+
+template<typename T>
+void Sort<T>::sortSmall(T* arr, int size, std::false_type)
+{
+	std::less<T> compare;
+
+	insertionSort(arr, arr + size, compare);
+}
+
+template<typename T>
+inline void Sort<T>::simdSortSmall(T* arr, int size, std::true_type)
+{
+	sortSmall(arr, size, std::true_type());
+}
+
+template<typename T>
+inline void Sort<T>::simdSortSmall(T*, int, std::false_type)
+{
+	// never called, simd is false
+}
+
+template<typename T>
+template<typename K>
+inline typename std::enable_if<std::is_integral<K>::value, int32_t>::type Sort<T>::toSimdKey(K key)
+{
+	return std::is_signed<K>::value ? (int32_t)key : (int32_t)((uint32_t)key ^ 0x80000000u);
+}
+
+template<typename T>
+inline int32_t Sort<T>::toSimdKey(float key)
+{
+	int32_t bits;
+
+	memcpy(&bits, &key, sizeof(bits));
+
+	// negative floats: flip all but the sign bit, so a larger magnitude comes first
+	return bits ^ ((bits >> 31) & 0x7FFFFFFF);
+}
+
+template<typename T>
+template<typename K>
+inline typename std::enable_if<std::is_integral<K>::value>::type Sort<T>::fromSimdKey(int32_t key, K& out)
+{
+	out = std::is_signed<K>::value ? (K)key : (K)((uint32_t)key ^ 0x80000000u);
+}
+
+template<typename T>
+inline void Sort<T>::fromSimdKey(int32_t key, float& out)
+{
+	// the mapping is its own inverse
+	key ^= (key >> 31) & 0x7FFFFFFF;
+
+	memcpy(&out, &key, sizeof(out));
+}
@@ -3,12 +3,28 @@
 #include "graphs/AMUndirectedGraph.h"
 #include "hash_tabels/ChainedHashTable.h"
 #include "hash_tabels/LPHashTable.h"
+#include "heaps/BinaryHeap.h"
+#include "heaps/BucketQueue.h"
+#include "heaps/DaryHeap.h"
+#include "heaps/IndexedMinHeap.h"
 #include "heaps/MaxHeap.h"
 #include "heaps/MinHeap.h"
+#include "heaps/MinMaxHeap.h"
+#include "heaps/MultiQueue.h"
+#include "heaps/PairingHeap.h"
+#include "heaps/RadixHeap.h"
+#include "heaps/TopK.h"
 #include "lists/DynamicArray.h"
+#include "lists/GapBuffer.h"
+#include "lists/PieceTable.h"
+#include "lists/PersistentVector.h"
+#include "lists/Rope.h"
+#include "lists/StaticSortedArray.h"
 #include "lists/linked_lists/SLinkedList.h"
 #include "lists/linked_lists/DLinkedList.h"
 #include "lists/skip_list/SkipList.h"
+#include "lists/skip_list/SkipListMap.h"
+#include "lists/skip_list/ConcurrentSkipList.h"
 #include "queues/AQueue.h"
 #include "queues/LQueue.h"
 #include "sets/DASet.h"
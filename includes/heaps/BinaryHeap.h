@@ -0,0 +1,424 @@
+#pragma once
+
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include "DaryHeap.h"
+#include "../lists/DynamicArray.h"
+
+/**
+ * A binary heap in a growable array, the core of MinHeap and MaxHeap.
+ * The element on top is the one that comes first by Compare (std::less gives a min. heap and
+ * std::greater a max. heap). The buffer is allocated with new[], like the one of DynamicArray,
+ * so a heap can be built in the buffer of a dynamic array and give it back, without copying.
+ * The sifts are the ones of DaryHeap with D = 2.
+ */
+template<typename T, typename Compare = std::less<T> >
+class BinaryHeap
+{
+public:
+	/**
+	 * @brief build an empty heap.
+	 * @param capacity the number of elements to make room for (the heap grows when it is full).
+	 * @param compare
+	*/
+	explicit BinaryHeap(const int capacity = DEFAULT_CAPACITY, Compare compare = Compare());
+
+	/**
+	 * @brief build a heap from a copy of a given array.
+	 * @param arr
+	 * @param size the size of the array and eventually the size of the heap.
+	 * @param compare
+	*/
+	BinaryHeap(const T* arr, const int size, Compare compare = Compare());
+
+	/**
+	 * @brief build a heap from a copy of a dynamic array.
+	 * @param arr
+	 * @param compare
+	*/
+	explicit BinaryHeap(const DynamicArray<T>& arr, Compare compare = Compare());
+
+	/**
+	 * @brief build a heap in the buffer of a dynamic array, without copying it.
+	 * @param arr is left empty.
+	 * @param compare
+	*/
+	explicit BinaryHeap(DynamicArray<T>&& arr, Compare compare = Compare());
+
+	~BinaryHeap();
+
+	BinaryHeap(const BinaryHeap& other) = delete;
+
+	BinaryHeap& operator=(const BinaryHeap& other) = delete;
+
+	/**
+	 * @brief get the index of the parent of the element at index i.
+	 * @param i
+	 * @return the parent's index, may not be a valid index in the heap.
+	*/
+	int parent(int i);
+
+	/**
+	 * @brief get the index of the left child of the element at index i.
+	 * @param i
+	 * @return the left child's index, may not be a valid index in the heap.
+	*/
+	int left(int i);
+
+	/**
+	 * @brief get the index of the right child of the element at index i.
+	 * @param i
+	 * @return the right child's index, may not be a valid index in the heap.
+	*/
+	int right(int i);
+
+	/**
+	 * @brief get the element on top of the heap and keep it in the heap.
+	*/
+	T top();
+
+	/**
+	 * @brief get the element on top of the heap and pop it out.
+	*/
+	T extractTop();
+
+	/**
+	 * @brief replace the key at a specific index with one that does not come after it, and move
+	 * it up to its place.
+	 * @param i
+	 * @param key
+	*/
+	void raiseKey(int i, T key);
+
+	/**
+	 * @brief insert a new key to the heap.
+	 * @param key
+	*/
+	void insert(T key);
+
+	/**
+	 * @brief build a new key from the given arguments and insert it to the heap.
+	 * the key is moved into its slot, and then moved along the sift.
+	 * @param args the arguments of T's constructor.
+	*/
+	template<typename... Args>
+	void emplace(Args&&... args);
+
+	/**
+	 * @brief give the heap's buffer back as a dynamic array (in heap order), without copying it.
+	 * the heap is left empty.
+	*/
+	DynamicArray<T> release();
+
+	int size();
+
+	/**
+	 * @brief check if this heap is empty.
+	 * @return true iff the heap is empty.
+	*/
+	bool isEmpty();
+
+	/**
+	 * @brief check if the heap is full.
+	 * @return true iff the heap is full (the next insertion grows it).
+	*/
+	bool isFull();
+
+	/**
+	 * @brief sort a given array in place: the top goes to the end, so std::less sorts in
+	 * decreasing order and std::greater in increasing order.
+	 * @param arr
+	 * @param size the array's size.
+	 * @param compare
+	*/
+	static void heapSort(T* arr, const int size, Compare compare = Compare());
+
+	/**
+	 * @brief sort a given dynamic array in place, see heapSort above.
+	 * @param arr
+	 * @param compare
+	*/
+	static void heapSort(DynamicArray<T>& arr, Compare compare = Compare());
+
+private:
+	// the sifts and the heap construction
+	typedef DaryHeap<T, 2, Compare> Binary;
+
+	static const int DEFAULT_CAPACITY = 16;
+	static const int GROWTH_FACTOR = 2;
+
+	T* arr_;
+	int capacity_;
+	int size_;
+
+	Compare compare_;
+
+	/**
+	 * @brief make room for one more element, doubling the buffer if it is full.
+	*/
+	void grow();
+};
+
+template<typename T, typename Compare>
+inline BinaryHeap<T, Compare>::BinaryHeap(const int capacity, Compare compare) : compare_(compare)
+{
+	capacity_ = capacity > 0 ? capacity : 1;
+	size_ = 0;
+	arr_ = new T[capacity_];
+}
+
+template<typename T, typename Compare>
+inline BinaryHeap<T, Compare>::BinaryHeap(const T* arr, const int size, Compare compare) : compare_(compare)
+{
+	capacity_ = size > 0 ? size : 1;
+	size_ = size;
+
+	arr_ = new T[capacity_];
+
+	for (int i = 0; i < size; i++)
+	{
+		arr_[i] = arr[i];
+	}
+
+	Binary::makeHeap(arr_, size_, compare_);
+}
+
+template<typename T, typename Compare>
+inline BinaryHeap<T, Compare>::BinaryHeap(const DynamicArray<T>& arr, Compare compare) : compare_(compare)
+{
+	capacity_ = arr.capacity_ > 0 ? arr.capacity_ : 1;
+	size_ = arr.size();
+
+	arr_ = new T[capacity_];
+
+	for (int i = 0; i < size_; i++)
+	{
+		arr_[i] = arr.array_[i];
+	}
+
+	Binary::makeHeap(arr_, size_, compare_);
+}
+
+template<typename T, typename Compare>
+inline BinaryHeap<T, Compare>::BinaryHeap(DynamicArray<T>&& arr, Compare compare) : compare_(compare)
+{
+	capacity_ = arr.capacity_;
+	size_ = arr.size_;
+	arr_ = arr.array_;
+
+	// the heap owns the buffer now, the array grows from nothing if it is used again
+	arr.array_ = nullptr;
+	arr.capacity_ = 0;
+	arr.size_ = 0;
+
+	// a zero capacity buffer (delete[] of nullptr does nothing) is replaced with a real one
+	if (!arr_ || capacity_ < 1)
+	{
+		delete[] arr_;
+
+		capacity_ = 1;
+		arr_ = new T[capacity_];
+	}
+
+	Binary::makeHeap(arr_, size_, compare_);
+}
+
+template<typename T, typename Compare>
+inline BinaryHeap<T, Compare>::~BinaryHeap()
+{
+	delete[] arr_;
+
+	size_ = -1;
+}
+
+template<typename T, typename Compare>
+inline int BinaryHeap<T, Compare>::parent(int i)
+{
+	if (i < 0)
+	{
+		throw std::invalid_argument("index cannot be negative");
+	}
+
+	if (i == 0)
+	{
+		throw std::logic_error("the first element does not have a parent");
+	}
+
+	if (i >= size_)
+	{
+		throw std::out_of_range("index out of range");
+	}
+
+	return (i - 1) / 2;
+}
+
+template<typename T, typename Compare>
+inline int BinaryHeap<T, Compare>::left(int i)
+{
+	if (i < 0)
+	{
+		throw std::invalid_argument("index cannot be negative");
+	}
+
+	if (i >= size_)
+	{
+		throw std::out_of_range("index out of range");
+	}
+
+	return 2 * i + 1;
+}
+
+template<typename T, typename Compare>
+inline int BinaryHeap<T, Compare>::right(int i)
+{
+	return left(i) + 1;
+}
+
+template<typename T, typename Compare>
+inline T BinaryHeap<T, Compare>::top()
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	return arr_[0];
+}
+
+template<typename T, typename Compare>
+inline T BinaryHeap<T, Compare>::extractTop()
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	T result = std::move(arr_[0]);
+
+	size_--;
+
+	// move the last element to the beginning, then fix the heap
+	if (!isEmpty())
+	{
+		arr_[0] = std::move(arr_[size_]);
+		Binary::siftDown(arr_, size_, 0, compare_);
+	}
+
+	return result;
+}
+
+template<typename T, typename Compare>
+inline void BinaryHeap<T, Compare>::raiseKey(int i, T key)
+{
+	if (i < 0 || i >= size_)
+	{
+		throw std::out_of_range("index out of range");
+	}
+
+	if (compare_(arr_[i], key))
+	{
+		throw std::logic_error("the new key comes after the original key");
+	}
+
+	arr_[i] = std::move(key);
+
+	Binary::siftUp(arr_, i, compare_);
+}
+
+template<typename T, typename Compare>
+inline void BinaryHeap<T, Compare>::insert(T key)
+{
+	grow();
+
+	arr_[size_] = std::move(key);
+	size_++;
+
+	Binary::siftUp(arr_, size_ - 1, compare_);
+}
+
+template<typename T, typename Compare>
+template<typename... Args>
+inline void BinaryHeap<T, Compare>::emplace(Args&&... args)
+{
+	grow();
+
+	arr_[size_] = T(std::forward<Args>(args)...);
+	size_++;
+
+	Binary::siftUp(arr_, size_ - 1, compare_);
+}
+
+template<typename T, typename Compare>
+inline DynamicArray<T> BinaryHeap<T, Compare>::release()
+{
+	DynamicArray<T> arr(0);
+
+	// swap the array's empty buffer for the heap's one
+	delete[] arr.array_;
+
+	arr.array_ = arr_;
+	arr.capacity_ = capacity_;
+	arr.size_ = size_;
+
+	// start over with a small buffer
+	capacity_ = 1;
+	size_ = 0;
+	arr_ = new T[capacity_];
+
+	return arr;
+}
+
+template<typename T, typename Compare>
+inline int BinaryHeap<T, Compare>::size()
+{
+	return size_;
+}
+
+template<typename T, typename Compare>
+inline bool BinaryHeap<T, Compare>::isEmpty()
+{
+	return size_ == 0;
+}
+
+template<typename T, typename Compare>
+inline bool BinaryHeap<T, Compare>::isFull()
+{
+	return size_ == capacity_;
+}
+
+template<typename T, typename Compare>
+inline void BinaryHeap<T, Compare>::heapSort(T* arr, const int size, Compare compare)
+{
+	Binary::heapSort(arr, size, compare);
+}
+
+template<typename T, typename Compare>
+inline void BinaryHeap<T, Compare>::heapSort(DynamicArray<T>& arr, Compare compare)
+{
+	Binary::heapSort(arr.array_, arr.size(), compare);
+}
+
+// PRIVATES
+
+template<typename T, typename Compare>
+inline void BinaryHeap<T, Compare>::grow()
+{
+	if (!isFull())
+	{
+		return;
+	}
+
+	capacity_ *= GROWTH_FACTOR;
+
+	T* newArr = new T[capacity_];
+
+	for (int i = 0; i < size_; i++)
+	{
+		newArr[i] = std::move(arr_[i]);
+	}
+
+	delete[] arr_;
+
+	arr_ = newArr;
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <stdexcept>
+#include "../lists/DynamicArray.h"
+
+/**
+ * A bucket queue: a minimum priority queue for integer priorities in a small range [0, range),
+ * with one bucket (a stack of values) per priority.
+ * insert is O(1), and extractMin scans the buckets from the lowest non-empty one - with
+ * monotone priorities (as in Dijkstra's algorithm with small edge weights) the scan never goes
+ * back, so all the extractions together cost O(n + range).
+ * Every priority carries a value (for example a vertex).
+ */
+template<typename V = int>
+class BucketQueue
+{
+public:
+	/**
+	 * @brief build an empty queue.
+	 * @param range the priorities are in [0, range).
+	*/
+	explicit BucketQueue(int range);
+
+	~BucketQueue();
+
+	BucketQueue(const BucketQueue& other) = delete;
+
+	BucketQueue& operator=(const BucketQueue& other) = delete;
+
+	/**
+	 * @brief insert a new priority to the queue.
+	 * @param priority in [0, range).
+	 * @param value
+	*/
+	void insert(int priority, V value = V());
+
+	/**
+	 * @brief get the minimum priority in the queue and keep it in the queue.
+	*/
+	int minimum();
+
+	/**
+	 * @brief get the minimum priority in the queue and pop it out.
+	*/
+	int extractMin();
+
+	/**
+	 * @brief get the minimum priority in the queue and pop it out.
+	 * @param value gets the priority's value.
+	*/
+	int extractMin(V& value);
+
+	int range();
+
+	int size();
+
+	bool isEmpty();
+
+private:
+	DynamicArray<V>* buckets_;
+
+	int range_;
+
+	int size_;
+
+	// no bucket below this one holds a value
+	int first_;
+
+	/**
+	 * @brief move first_ to the lowest non-empty bucket.
+	*/
+	void seek();
+};
+
+template<typename V>
+BucketQueue<V>::BucketQueue(int range)
+{
+	if (range < 1)
+	{
+		throw std::invalid_argument("the range should be positive");
+	}
+
+	range_ = range;
+	size_ = 0;
+	first_ = range;
+
+	buckets_ = new DynamicArray<V>[range_];
+}
+
+template<typename V>
+BucketQueue<V>::~BucketQueue()
+{
+	delete[] buckets_;
+
+	buckets_ = nullptr;
+	size_ = -1;
+}
+
+template<typename V>
+void BucketQueue<V>::insert(int priority, V value)
+{
+	if (priority < 0 || priority >= range_)
+	{
+		throw std::out_of_range("the priority is out of range");
+	}
+
+	buckets_[priority].add(value);
+	size_++;
+
+	if (priority < first_)
+	{
+		first_ = priority;
+	}
+}
+
+template<typename V>
+int BucketQueue<V>::minimum()
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	seek();
+
+	return first_;
+}
+
+template<typename V>
+int BucketQueue<V>::extractMin()
+{
+	V value;
+
+	return extractMin(value);
+}
+
+template<typename V>
+int BucketQueue<V>::extractMin(V& value)
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	seek();
+
+	value = buckets_[first_].removeLast();
+	size_--;
+
+	return first_;
+}
+
+template<typename V>
+inline int BucketQueue<V>::range()
+{
+	return range_;
+}
+
+template<typename V>
+inline int BucketQueue<V>::size()
+{
+	return size_;
+}
+
+template<typename V>
+inline bool BucketQueue<V>::isEmpty()
+{
+	return size_ == 0;
+}
+
+// PRIVATES
+
+template<typename V>
+inline void BucketQueue<V>::seek()
+{
+	while (buckets_[first_].isEmpty())
+	{
+		first_++;
+	}
+}
@@ -0,0 +1,427 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * A d-ary heap: every node has D children (D = 2, 4, 8...).
+ * The element on top is the one that comes first by Compare - std::less gives a min. heap
+ * and std::greater gives a max. heap, so the same code serves both.
+ * The children of a node are stored together, and the buffer is aligned so that
+ * each group of children starts on its own part of a cache line (when D * sizeof(T) divides 64):
+ * a sift down touches one line per level, and there are only log_D(n) levels.
+ * The sifts move a hole instead of swapping, so each level costs one move.
+ * The sifts, the heap construction and heapSort also work on plain arrays, MinHeap and MaxHeap
+ * use them with D = 2.
+ */
+template<typename T, int D = 4, typename Compare = std::less<T> >
+class DaryHeap
+{
+	static_assert(D >= 2, "a d-ary heap needs at least 2 children per node");
+
+public:
+	// Constructors
+
+	/**
+	 * @brief build an empty heap.
+	 * @param capacity the number of elements to make room for (the heap grows as needed).
+	 * @param compare
+	*/
+	explicit DaryHeap(int capacity = DEFAULT_CAPACITY, Compare compare = Compare());
+
+	/**
+	 * @brief build a heap from a given array in O(n) (Floyd's method).
+	 * @param arr
+	 * @param size the size of the array.
+	 * @param compare
+	*/
+	DaryHeap(const T* arr, int size, Compare compare = Compare());
+
+	~DaryHeap();
+
+	DaryHeap(const DaryHeap& other) = delete;
+
+	DaryHeap& operator=(const DaryHeap& other) = delete;
+
+	// Operations
+
+	/**
+	 * @brief get the element on top of the heap and keep it in the heap.
+	*/
+	const T& top() const;
+
+	/**
+	 * @brief get the element on top of the heap and pop it out.
+	*/
+	T extractTop();
+
+	/**
+	 * @brief insert a new element to the heap.
+	 * @param key
+	*/
+	void insert(T key);
+
+	/**
+	 * @brief pop the element on top and insert a new one, with a single sift down.
+	 * @param key
+	 * @return the element that was on top.
+	*/
+	T replaceTop(T key);
+
+	/**
+	 * @brief make room for a number of elements, so inserting them does not reallocate.
+	 * @param capacity
+	*/
+	void reserve(int capacity);
+
+	// Getters
+
+	int size() const;
+
+	bool isEmpty() const;
+
+	/**
+	 * @brief get the elements in heap order (the top first), size() of them.
+	*/
+	const T* data() const;
+
+	// Algorithms on arrays
+
+	/**
+	 * @brief arrange an array into a heap in O(n) (Floyd's method).
+	 * @param arr
+	 * @param size the size of the array.
+	 * @param compare
+	*/
+	static void makeHeap(T* arr, int size, Compare compare = Compare());
+
+	/**
+	 * @brief sort an array in place: the top of the heap is moved to the end, again and again,
+	 * so std::less sorts in decreasing order and std::greater in increasing order.
+	 * @param arr
+	 * @param size the size of the array.
+	 * @param compare
+	*/
+	static void heapSort(T* arr, int size, Compare compare = Compare());
+
+	/**
+	 * @brief move the element at index i of a heap up to its place.
+	*/
+	static void siftUp(T* arr, int i, Compare& compare);
+
+	/**
+	 * @brief move the element at index i of a heap of size elements down to its place.
+	*/
+	static void siftDown(T* arr, int size, int i, Compare& compare);
+
+private:
+	static const int DEFAULT_CAPACITY = 16;
+	static const int CACHE_LINE = 64;
+
+	// the raw block, the heap is built inside it
+	void* block_;
+
+	// logical index i is stored in slots_[i + D - 1], so the children of i start at slots_[D * (i + 1)]
+	T* slots_;
+	T* arr_;
+
+	int capacity_;
+	int size_;
+
+	Compare compare_;
+
+	/**
+	 * @brief allocate a block for a given capacity, aligned for the children groups.
+	 * @param slots gets the first slot in the block.
+	 * @return the block.
+	*/
+	static void* allocate(int capacity, T*& slots);
+};
+
+// Constructors
+
+template<typename T, int D, typename Compare>
+DaryHeap<T, D, Compare>::DaryHeap(int capacity, Compare compare) : compare_(compare)
+{
+	if (capacity < 0)
+	{
+		throw std::invalid_argument("capacity cannot be negative");
+	}
+
+	capacity_ = capacity > 0 ? capacity : 1;
+	size_ = 0;
+
+	block_ = allocate(capacity_, slots_);
+	arr_ = slots_ + D - 1;
+}
+
+template<typename T, int D, typename Compare>
+DaryHeap<T, D, Compare>::DaryHeap(const T* arr, int size, Compare compare) : compare_(compare)
+{
+	if (size < 0)
+	{
+		throw std::invalid_argument("size cannot be negative");
+	}
+
+	capacity_ = size > 0 ? size : 1;
+	size_ = 0;
+
+	block_ = allocate(capacity_, slots_);
+	arr_ = slots_ + D - 1;
+
+	for (; size_ < size; size_++)
+	{
+		new (arr_ + size_) T(arr[size_]);
+	}
+
+	makeHeap(arr_, size_, compare_);
+}
+
+template<typename T, int D, typename Compare>
+DaryHeap<T, D, Compare>::~DaryHeap()
+{
+	for (int i = 0; i < size_; i++)
+	{
+		arr_[i].~T();
+	}
+
+	::operator delete(block_);
+
+	block_ = nullptr;
+	size_ = 0;
+}
+
+// Operations
+
+template<typename T, int D, typename Compare>
+inline const T& DaryHeap<T, D, Compare>::top() const
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	return arr_[0];
+}
+
+template<typename T, int D, typename Compare>
+T DaryHeap<T, D, Compare>::extractTop()
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	T result = std::move(arr_[0]);
+
+	size_--;
+
+	// the last element goes to the root's hole, then sinks down
+	if (size_ > 0)
+	{
+		arr_[0] = std::move(arr_[size_]);
+	}
+
+	arr_[size_].~T();
+
+	if (size_ > 1)
+	{
+		siftDown(arr_, size_, 0, compare_);
+	}
+
+	return result;
+}
+
+template<typename T, int D, typename Compare>
+void DaryHeap<T, D, Compare>::insert(T key)
+{
+	if (size_ == capacity_)
+	{
+		reserve(2 * capacity_);
+	}
+
+	new (arr_ + size_) T(std::move(key));
+	size_++;
+
+	siftUp(arr_, size_ - 1, compare_);
+}
+
+template<typename T, int D, typename Compare>
+T DaryHeap<T, D, Compare>::replaceTop(T key)
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	T result = std::move(arr_[0]);
+
+	arr_[0] = std::move(key);
+	siftDown(arr_, size_, 0, compare_);
+
+	return result;
+}
+
+template<typename T, int D, typename Compare>
+void DaryHeap<T, D, Compare>::reserve(int capacity)
+{
+	if (capacity <= capacity_)
+	{
+		return;
+	}
+
+	T* slots;
+	void* block = allocate(capacity, slots);
+	T* arr = slots + D - 1;
+
+	for (int i = 0; i < size_; i++)
+	{
+		new (arr + i) T(std::move(arr_[i]));
+		arr_[i].~T();
+	}
+
+	::operator delete(block_);
+
+	block_ = block;
+	slots_ = slots;
+	arr_ = arr;
+	capacity_ = capacity;
+}
+
+// Getters
+
+template<typename T, int D, typename Compare>
+inline int DaryHeap<T, D, Compare>::size() const
+{
+	return size_;
+}
+
+template<typename T, int D, typename Compare>
+inline bool DaryHeap<T, D, Compare>::isEmpty() const
+{
+	return size_ == 0;
+}
+
+template<typename T, int D, typename Compare>
+inline const T* DaryHeap<T, D, Compare>::data() const
+{
+	return arr_;
+}
+
+// Algorithms on arrays
+
+template<typename T, int D, typename Compare>
+void DaryHeap<T, D, Compare>::makeHeap(T* arr, int size, Compare compare)
+{
+	// fix each internal node, from the deepest one up to the root
+	for (int i = (size - 2) / D; i >= 0 && size > 1; i--)
+	{
+		siftDown(arr, size, i, compare);
+	}
+}
+
+template<typename T, int D, typename Compare>
+void DaryHeap<T, D, Compare>::heapSort(T* arr, int size, Compare compare)
+{
+	makeHeap(arr, size, compare);
+
+	// move the top to the end of the heap, then fix the rest
+	for (int i = size - 1; i > 0; i--)
+	{
+		std::swap(arr[0], arr[i]);
+		siftDown(arr, i, 0, compare);
+	}
+}
+
+template<typename T, int D, typename Compare>
+void DaryHeap<T, D, Compare>::siftUp(T* arr, int i, Compare& compare)
+{
+	T item = std::move(arr[i]);
+
+	// move the parents down into the hole while the item comes before them
+	while (i > 0)
+	{
+		int parent = (i - 1) / D;
+
+		if (!compare(item, arr[parent]))
+		{
+			break;
+		}
+
+		arr[i] = std::move(arr[parent]);
+		i = parent;
+	}
+
+	arr[i] = std::move(item);
+}
+
+template<typename T, int D, typename Compare>
+void DaryHeap<T, D, Compare>::siftDown(T* arr, int size, int i, Compare& compare)
+{
+	T item = std::move(arr[i]);
+
+	while (true)
+	{
+		int first = D * i + 1;
+
+		if (first >= size)
+		{
+			break;
+		}
+
+		int best = first;
+
+		// find the first child by the comparator, the loop over a full group has a fixed length
+		if (first + D <= size)
+		{
+			for (int c = 1; c < D; c++)
+			{
+				if (compare(arr[first + c], arr[best]))
+				{
+					best = first + c;
+				}
+			}
+		}
+		else
+		{
+			for (int child = first + 1; child < size; child++)
+			{
+				if (compare(arr[child], arr[best]))
+				{
+					best = child;
+				}
+			}
+		}
+
+		if (!compare(arr[best], item))
+		{
+			break;
+		}
+
+		arr[i] = std::move(arr[best]);
+		i = best;
+	}
+
+	arr[i] = std::move(item);
+}
+
+// PRIVATES
+
+template<typename T, int D, typename Compare>
+void* DaryHeap<T, D, Compare>::allocate(int capacity, T*& slots)
+{
+	// D - 1 unused slots before the root, and a line of slack to align the first slot
+	void* block = ::operator new((capacity + D - 1) * sizeof(T) + CACHE_LINE);
+
+	uintptr_t address = reinterpret_cast<uintptr_t>(block);
+
+	address = (address + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+
+	slots = reinterpret_cast<T*>(address);
+
+	return block;
+}
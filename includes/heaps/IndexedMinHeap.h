@@ -0,0 +1,408 @@
+#pragma once
+
+#include <stdexcept>
+#include <utility>
+#include "../lists/DynamicArray.h"
+
+/**
+ * A minimum heap that gives every inserted key a stable handle.
+ * The heap holds handles, and a position map (handle -> index in the heap) is updated on
+ * every move of a sift, so a key can be changed or erased by its handle in O(log n) -
+ * as Dijkstra's and Prim's algorithms need.
+ * A handle stays valid until its key leaves the heap, then it may be given to a new key.
+ */
+template<typename T>
+class IndexedMinHeap
+{
+public:
+	/**
+	 * @brief build a new indexed minimum heap.
+	 * @param capacity the number of keys to make room for (the heap grows when it is full).
+	*/
+	explicit IndexedMinHeap(int capacity = DEFAULT_CAPACITY);
+
+	~IndexedMinHeap();
+
+	IndexedMinHeap(const IndexedMinHeap<T>& other) = delete;
+
+	IndexedMinHeap<T>& operator=(const IndexedMinHeap<T>& other) = delete;
+
+	/**
+	 * @brief insert a new key to the heap.
+	 * @param key
+	 * @return the key's handle.
+	*/
+	int insert(T key);
+
+	/**
+	 * @brief get the minimum key in the heap and keep it in the heap.
+	*/
+	T minimum();
+
+	/**
+	 * @brief get the handle of the minimum key in the heap.
+	*/
+	int minimumHandle();
+
+	/**
+	 * @brief get the minimum key in the heap and pop it out.
+	*/
+	T extractMin();
+
+	/**
+	 * @brief get the minimum key in the heap and pop it out.
+	 * @param handle gets the key's handle (which is then released).
+	*/
+	T extractMin(int& handle);
+
+	/**
+	 * @brief get the key of a handle.
+	 * @param handle
+	*/
+	T get(int handle);
+
+	/**
+	 * @brief decrease the key of a handle.
+	 * @param handle
+	 * @param key not greater than the current key.
+	*/
+	void decreaseKey(int handle, T key);
+
+	/**
+	 * @brief increase the key of a handle.
+	 * @param handle
+	 * @param key not smaller than the current key.
+	*/
+	void increaseKey(int handle, T key);
+
+	/**
+	 * @brief remove the key of a handle from the heap.
+	 * @param handle
+	*/
+	void erase(int handle);
+
+	/**
+	 * @brief check if a handle belongs to a key in the heap.
+	 * @param handle
+	*/
+	bool contains(int handle);
+
+	int size();
+
+	bool isEmpty();
+
+private:
+	static const int DEFAULT_CAPACITY = 16;
+	static const int GROWTH_FACTOR = 2;
+
+	// the keys by their handles
+	T* keys_;
+
+	// the index of each handle in the heap, -1 for a free handle
+	int* positions_;
+
+	// the handles in heap order
+	int* heap_;
+
+	// the number of handles given so far, and the room for them
+	int handles_;
+	int capacity_;
+
+	int size_;
+
+	// released handles, given again before new ones
+	DynamicArray<int> free_;
+
+	/**
+	 * @brief make room for one more handle.
+	*/
+	void grow();
+
+	void checkHandle(int handle);
+
+	/**
+	 * @brief put a handle in an index of the heap and update its position.
+	*/
+	void place(int index, int handle);
+
+	/**
+	 * @brief move the handle at index i up while its key is smaller than its parent's.
+	*/
+	void siftUp(int i);
+
+	/**
+	 * @brief move the handle at index i down while its key is greater than one of its children's.
+	*/
+	void siftDown(int i);
+
+	/**
+	 * @brief take the handle at index i out of the heap and release it.
+	*/
+	void removeAt(int i);
+};
+
+template<typename T>
+IndexedMinHeap<T>::IndexedMinHeap(int capacity)
+{
+	capacity_ = capacity > 0 ? capacity : 1;
+	handles_ = 0;
+	size_ = 0;
+
+	keys_ = new T[capacity_];
+	positions_ = new int[capacity_];
+	heap_ = new int[capacity_];
+}
+
+template<typename T>
+IndexedMinHeap<T>::~IndexedMinHeap()
+{
+	delete[] keys_;
+	delete[] positions_;
+	delete[] heap_;
+
+	size_ = -1;
+}
+
+template<typename T>
+int IndexedMinHeap<T>::insert(T key)
+{
+	int handle;
+
+	if (free_.isEmpty())
+	{
+		grow();
+		handle = handles_++;
+	}
+	else
+	{
+		handle = free_.removeLast();
+	}
+
+	keys_[handle] = std::move(key);
+
+	place(size_, handle);
+	size_++;
+
+	siftUp(size_ - 1);
+
+	return handle;
+}
+
+template<typename T>
+inline T IndexedMinHeap<T>::minimum()
+{
+	return keys_[minimumHandle()];
+}
+
+template<typename T>
+inline int IndexedMinHeap<T>::minimumHandle()
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	return heap_[0];
+}
+
+template<typename T>
+inline T IndexedMinHeap<T>::extractMin()
+{
+	int handle;
+
+	return extractMin(handle);
+}
+
+template<typename T>
+T IndexedMinHeap<T>::extractMin(int& handle)
+{
+	handle = minimumHandle();
+
+	T min = std::move(keys_[handle]);
+
+	removeAt(0);
+
+	return min;
+}
+
+template<typename T>
+inline T IndexedMinHeap<T>::get(int handle)
+{
+	checkHandle(handle);
+
+	return keys_[handle];
+}
+
+template<typename T>
+void IndexedMinHeap<T>::decreaseKey(int handle, T key)
+{
+	checkHandle(handle);
+
+	if (keys_[handle] < key)
+	{
+		throw std::logic_error("the new key is greater than the original key");
+	}
+
+	keys_[handle] = std::move(key);
+
+	siftUp(positions_[handle]);
+}
+
+template<typename T>
+void IndexedMinHeap<T>::increaseKey(int handle, T key)
+{
+	checkHandle(handle);
+
+	if (key < keys_[handle])
+	{
+		throw std::logic_error("the new key is smaller than the original key");
+	}
+
+	keys_[handle] = std::move(key);
+
+	siftDown(positions_[handle]);
+}
+
+template<typename T>
+void IndexedMinHeap<T>::erase(int handle)
+{
+	checkHandle(handle);
+
+	removeAt(positions_[handle]);
+}
+
+template<typename T>
+inline bool IndexedMinHeap<T>::contains(int handle)
+{
+	return handle >= 0 && handle < handles_ && positions_[handle] >= 0;
+}
+
+template<typename T>
+inline int IndexedMinHeap<T>::size()
+{
+	return size_;
+}
+
+template<typename T>
+inline bool IndexedMinHeap<T>::isEmpty()
+{
+	return size_ == 0;
+}
+
+template<typename T>
+void IndexedMinHeap<T>::grow()
+{
+	if (handles_ < capacity_)
+	{
+		return;
+	}
+
+	int capacity = capacity_ * GROWTH_FACTOR;
+
+	T* keys = new T[capacity];
+	int* positions = new int[capacity];
+	int* heap = new int[capacity];
+
+	for (int i = 0; i < handles_; i++)
+	{
+		keys[i] = std::move(keys_[i]);
+		positions[i] = positions_[i];
+	}
+
+	for (int i = 0; i < size_; i++)
+	{
+		heap[i] = heap_[i];
+	}
+
+	delete[] keys_;
+	delete[] positions_;
+	delete[] heap_;
+
+	keys_ = keys;
+	positions_ = positions;
+	heap_ = heap;
+	capacity_ = capacity;
+}
+
+template<typename T>
+inline void IndexedMinHeap<T>::checkHandle(int handle)
+{
+	if (!contains(handle))
+	{
+		throw std::invalid_argument("this handle is not in the heap");
+	}
+}
+
+template<typename T>
+inline void IndexedMinHeap<T>::place(int index, int handle)
+{
+	heap_[index] = handle;
+	positions_[handle] = index;
+}
+
+template<typename T>
+void IndexedMinHeap<T>::siftUp(int i)
+{
+	int handle = heap_[i];
+
+	// while the key is smaller than the key of the hole's parent, move the parent down
+	while (i && keys_[handle] < keys_[heap_[(i - 1) / 2]])
+	{
+		place(i, heap_[(i - 1) / 2]);
+		i = (i - 1) / 2;
+	}
+
+	place(i, handle);
+}
+
+template<typename T>
+void IndexedMinHeap<T>::siftDown(int i)
+{
+	int handle = heap_[i];
+
+	while (2 * i + 1 < size_)
+	{
+		int smallest = 2 * i + 1;
+
+		// find the smaller child
+		if (smallest + 1 < size_ && keys_[heap_[smallest + 1]] < keys_[heap_[smallest]])
+		{
+			smallest++;
+		}
+
+		if (!(keys_[heap_[smallest]] < keys_[handle]))
+		{
+			break;
+		}
+
+		place(i, heap_[smallest]);
+		i = smallest;
+	}
+
+	place(i, handle);
+}
+
+template<typename T>
+void IndexedMinHeap<T>::removeAt(int i)
+{
+	int handle = heap_[i];
+
+	size_--;
+
+	// the last handle fills the hole, then moves up or down to its place
+	if (i < size_)
+	{
+		int moved = heap_[size_];
+
+		place(i, moved);
+		siftUp(i);
+
+		if (positions_[moved] == i)
+		{
+			siftDown(i);
+		}
+	}
+
+	positions_[handle] = -1;
+	free_.add(handle);
+}
@@ -1,15 +1,22 @@
 #pragma once
 
-#include <stdexcept>
+#include <functional>
+#include <utility>
+#include "BinaryHeap.h"
 #include "../lists/DynamicArray.h"
 
+/**
+ * A binary min heap: a BinaryHeap ordered by std::less, with the min. heap names.
+ */
 template<typename T>
-class MinHeap
+class MinHeap : private BinaryHeap<T, std::less<T> >
 {
+	typedef BinaryHeap<T, std::less<T> > Heap;
+
 public:
 	/**
 	 * @brief build a new minimum heap.
-	 * @param capacity the maximal number of elements in the heap.
+	 * @param capacity the number of elements to make room for (the heap grows when it is full).
 	*/
 	MinHeap(const int capacity);
 
@@ -20,346 +27,112 @@ public:
 	*/
 	MinHeap(T* arr, const int size);
 
-	MinHeap(DynamicArray<T> arr);
-
-	~MinHeap();
-
 	/**
-	 * @brief get the index of the parent of the element at index i.
-	 * @param i
-	 * @return the parent's index, may not be a valid index in the heap.
+	 * @brief build a minimum heap from a copy of a dynamic array.
+	 * @param arr
 	*/
-	int parent(int i);
+	MinHeap(const DynamicArray<T>& arr);
 
 	/**
-	 * @brief get the index of the left child of the element at index i.
-	 * @param i
-	 * @return the left child's index, may not be a valid index in the heap.
+	 * @brief build a minimum heap in the buffer of a dynamic array, without copying it.
+	 * @param arr is left empty.
 	*/
-	int left(int i);
+	MinHeap(DynamicArray<T>&& arr);
 
-	/**
-	 * @brief get the index of the right child of the element at index i.
-	 * @param i
-	 * @return the right child's index, may not be a valid index in the heap.
-	*/
-	int right(int i);
+	MinHeap(const MinHeap<T>& other) = delete;
+
+	MinHeap<T>& operator=(const MinHeap<T>& other) = delete;
+
+	// the index helpers, the insertions, release and the getters of BinaryHeap
+	using Heap::parent;
+	using Heap::left;
+	using Heap::right;
+	using Heap::insert;
+	using Heap::emplace;
+	using Heap::release;
+	using Heap::size;
+	using Heap::isEmpty;
+	using Heap::isFull;
 
 	/**
-	 * @brief get the minimum element in the heap keep it in the heap.
-	 * @return the maximum number in the heap.
+	 * @brief get the minimum element in the heap and keep it in the heap.
+	 * @return the minimum element in the heap.
 	*/
 	T minimum();
 
 	/**
-	 * @brief get the maximum element in the heap and pop is out.
-	 * @return the maximum number in the heap.
+	 * @brief get the minimum element in the heap and pop it out.
+	 * @return the minimum element in the heap.
 	*/
 	T extractMin();
 
 	/**
-	 * @brief increase the key at a specific index.
+	 * @brief decrease the key at a specific index.
 	 * @param i
-	 * @param key
+	 * @param key not greater than the key at index i.
 	*/
 	void decreaseKey(int i, T key);
 
 	/**
-	 * @brief insert a new key to the heap.
-	 * @param key
-	*/
-	void insert(T key);
-
-	/**
-	 * @brief check if this heap is empty.
-	 * @return true iff the heap is empty.
-	*/
-	bool isEmpty();
-
-	/**
-	 * @brief check if the heap is full.
-	 * @return true iff the heap is full.
-	*/
-	bool isFull();
-
-	/**
-	 * @brief sort a given array using a min. heap (decreading).
+	 * @brief sort a given array in place using a min. heap (decreasing).
 	 * @param arr
 	 * @param size the array's size.
 	*/
 	static void heapSort(T* arr, const int size);
 
-	static void heapSort(DynamicArray<T> arr);
-
-private:
-	T* arr_;
-	int capacity_;
-	int size_;
-
-
-	// used in insertion and in key increasing, marks the last element as positive inifinity
-	bool lastIsPosInf_;
-
 	/**
-	 * @brief make sure that the subree rooted at index i satisfies the max. heap properties,
-	 * assuming its left and right subtrees do too.
-	 * @param i
+	 * @brief sort a given dynamic array in place using a min. heap (decreasing).
+	 * @param arr
 	*/
-	void MinHeapify(int i);
+	static void heapSort(DynamicArray<T>& arr);
 };
 
 template<typename T>
-inline MinHeap<T>::MinHeap(const int capacity)
-{
-	capacity_ = capacity;
-	size_ = 0;
-	arr_ = new T[capacity];
-	lastIsPosInf_ = false;
-}
-
-template<typename T>
-inline MinHeap<T>::MinHeap(T* arr, const int size)
-{
-	capacity_ = size;
-	size_ = size;
-	lastIsPosInf_ = false;
-
-	arr_ = new T[capacity_];
-
-	for (int i = 0; i < size; i++)
-	{
-		arr_[i] = arr[i];
-	}
-
-	// start at the deepest internal "node", then fix each "node" before it 
-	for (int i = parent(size - 1); i >= 0; i--)
-	{
-		MinHeapify(i);
-	}
-}
-
-template<typename T>
-inline MinHeap<T>::MinHeap(DynamicArray<T> arr)
+inline MinHeap<T>::MinHeap(const int capacity) : Heap(capacity)
 {
-	capacity_ = arr.capacity();
-	size_ = arr.size();
-	lastIsPosInf_ = false;
-
-	arr_ = new T[capacity_];
-
-	for (int i = 0; i < size_; i++)
-	{
-		arr_[i] = arr[i];
-	}
-
-	// start at the deepest internal "node", then fix each "node" before it 
-	for (int i = parent(size_ - 1); i >= 0; i--)
-	{
-		MinHeapify(i);
-	}
-}
-
-template<typename T>
-inline MinHeap<T>::~MinHeap()
-{
-
-	delete[] arr_;
-
-	size_ = -1;
 }
 
 template<typename T>
-inline int MinHeap<T>::parent(int i)
+inline MinHeap<T>::MinHeap(T* arr, const int size) : Heap(arr, size)
 {
-	if (i < 0)
-	{
-		throw std::invalid_argument("index cannot be negative");
-	}
-
-	if (i == 0)
-	{
-		throw std::logic_error("the first element does not have a parent");
-	}
-
-	if (i >= size_)
-	{
-		throw std::out_of_range("index out of range");
-	}
-
-	return (i - 1) / 2;
 }
 
 template<typename T>
-inline int MinHeap<T>::left(int i)
+inline MinHeap<T>::MinHeap(const DynamicArray<T>& arr) : Heap(arr)
 {
-	if (i < 0)
-	{
-		throw std::invalid_argument("index cannot be negative");
-	}
-
-	if (i >= size_)
-	{
-		throw std::out_of_range("index out of range");
-	}
-
-	return 2 * i + 1;
 }
 
 template<typename T>
-inline int MinHeap<T>::right(int i)
+inline MinHeap<T>::MinHeap(DynamicArray<T>&& arr) : Heap(std::move(arr))
 {
-	return left(i) + 1;
 }
 
 template<typename T>
 inline T MinHeap<T>::minimum()
 {
-	if (isEmpty())
-	{
-		throw std::underflow_error("this heap is empty");
-	}
-
-	return arr_[0];
+	return Heap::top();
 }
 
 template<typename T>
 inline T MinHeap<T>::extractMin()
 {
-	if (isEmpty())
-	{
-		throw std::underflow_error("this heap is empty");
-	}
-
-	T min = minimum();
-
-	// move the last element to the beginning, then fix the heap
-
-	if (!isEmpty())
-	{
-		arr_[0] = arr_[size_ - 1];
-	}
-
-	size_--;
-
-	if (!isEmpty())
-	{
-		MinHeapify(0);
-	}
-
-	return min;
+	return Heap::extractTop();
 }
 
 template<typename T>
 inline void MinHeap<T>::decreaseKey(int i, T key)
 {
-	if (i >= size_)
-	{
-		throw std::out_of_range("index out of range");
-	}
-
-	// if we treat the last element as inifinity, no need to check
-	// else, check that the key is really bigger
-	if (!(lastIsPosInf_ && i == size_ - 1) && key > arr_[i])
-	{
-		throw std::logic_error("the new key is greater than the original key");
-	}
-
-	arr_[i] = key;
-
-	lastIsPosInf_ = false;
-
-	// while the current is smaller than its parent, swap them
-	while (i && arr_[parent(i)] > arr_[i])
-	{
-		// swap the current and its parent
-		T tmp = arr_[parent(i)];
-		arr_[parent(i)] = arr_[i];
-		arr_[i] = tmp;
-
-		i = parent(i);
-	}
-}
-
-template<typename T>
-inline void MinHeap<T>::insert(T key)
-{
-	if (isFull())
-	{
-		throw std::overflow_error("this heap is full");
-	}
-
-	lastIsPosInf_ = true;
-	size_++;
-
-	decreaseKey(size_ - 1, key);
-}
-
-template<typename T>
-inline bool MinHeap<T>::isEmpty()
-{
-	return size_ == 0;
-}
-
-template<typename T>
-inline bool MinHeap<T>::isFull()
-{
-	return size_ == capacity_;
+	Heap::raiseKey(i, std::move(key));
 }
 
 template<typename T>
 inline void MinHeap<T>::heapSort(T* arr, const int size)
 {
-	MinHeap<T> heap(arr, size);
-
-	for (int i = size - 1; i >= 0; i--)
-	{
-		arr[i] = heap.extractMin();
-	}
-}
-
-template<typename T>
-inline void MinHeap<T>::heapSort(DynamicArray<T> arr)
-{
-	MinHeap<T> heap(arr, arr.size());
-
-	for (int i = arr.size() - 1; i >= 0; i--)
-	{
-		arr[i] = heap.extractMin();
-	}
+	Heap::heapSort(arr, size);
 }
 
 template<typename T>
-inline void MinHeap<T>::MinHeapify(int i)
+inline void MinHeap<T>::heapSort(DynamicArray<T>& arr)
 {
-	if (i >= size_)
-	{
-		throw std::out_of_range("index out of range");
-	}
-
-	int leftIndex = left(i), rightIndex = right(i), smallest = i;
-
-	// find where the smallest element between this node and its children
-
-	if (leftIndex < size_ && arr_[leftIndex] < arr_[smallest])
-	{
-		smallest = leftIndex;
-	}
-
-	if (rightIndex < size_ && arr_[rightIndex] < arr_[smallest])
-	{
-		smallest = rightIndex;
-	}
-
-	// it this node is not the smallest, rearrange the array
-
-	if (smallest != i)
-	{
-		// swap this and the larger child
-		T tmp = arr_[smallest];
-		arr_[smallest] = arr_[i];
-		arr_[i] = tmp;
-
-		// check the new subtree
-		MinHeapify(smallest);
-	}
+	Heap::heapSort(arr);
 }
@@ -0,0 +1,451 @@
+#pragma once
+
+#include <stdexcept>
+#include <utility>
+#include "../lists/DynamicArray.h"
+
+/**
+ * A min-max heap: a double ended priority queue in one array.
+ * The levels of the tree alternate - a node on an even level (the root's) is the minimum of
+ * its subtree, and a node on an odd level is the maximum of its subtree.
+ * So the minimum is the root and the maximum is one of its children, and both can be
+ * extracted in O(log n), instead of keeping a MinHeap and a MaxHeap of the same elements.
+ */
+template<typename T>
+class MinMaxHeap
+{
+public:
+	/**
+	 * @brief build a new min-max heap.
+	 * @param capacity the number of elements to make room for (the heap grows when it is full).
+	*/
+	explicit MinMaxHeap(const int capacity = DEFAULT_CAPACITY);
+
+	/**
+	 * @brief build a min-max heap from a given array in O(n).
+	 * @param arr
+	 * @param size the size of the array and eventually the size of the heap.
+	*/
+	MinMaxHeap(T* arr, const int size);
+
+	/**
+	 * @brief build a min-max heap from a copy of a dynamic array in O(n).
+	 * @param arr
+	*/
+	MinMaxHeap(const DynamicArray<T>& arr);
+
+	/**
+	 * @brief build a min-max heap in the buffer of a dynamic array in O(n), without copying it.
+	 * @param arr is left empty.
+	*/
+	MinMaxHeap(DynamicArray<T>&& arr);
+
+	~MinMaxHeap();
+
+	MinMaxHeap(const MinMaxHeap<T>& other) = delete;
+
+	MinMaxHeap<T>& operator=(const MinMaxHeap<T>& other) = delete;
+
+	/**
+	 * @brief get the minimum element in the heap and keep it in the heap.
+	*/
+	T minimum();
+
+	/**
+	 * @brief get the maximum element in the heap and keep it in the heap.
+	*/
+	T maximum();
+
+	/**
+	 * @brief get the minimum element in the heap and pop it out.
+	*/
+	T extractMin();
+
+	/**
+	 * @brief get the maximum element in the heap and pop it out.
+	*/
+	T extractMax();
+
+	/**
+	 * @brief insert a new key to the heap.
+	 * @param key
+	*/
+	void insert(T key);
+
+	int size();
+
+	bool isEmpty();
+
+private:
+	static const int DEFAULT_CAPACITY = 16;
+	static const int GROWTH_FACTOR = 2;
+
+	T* arr_;
+	int capacity_;
+	int size_;
+
+	/**
+	 * @brief check if index i is on a min. level (an even level, counting the root's as 0).
+	*/
+	static bool isMinLevel(int i);
+
+	/**
+	 * @brief get the index of the maximum element.
+	*/
+	int maxIndex();
+
+	/**
+	 * @brief remove the element at index i (the minimum or the maximum), filling it with the last one.
+	*/
+	T removeAt(int i);
+
+	/**
+	 * @brief make sure that the subtree rooted at index i is a min-max heap,
+	 * assuming the subtrees of its children are.
+	*/
+	void pushDown(int i);
+
+	/**
+	 * @brief pushDown for a node on a min. level (isMin) or on a max. level.
+	 * the element at i goes down by grandchildren, the first (by the level) of its
+	 * children and grandchildren takes its place.
+	 * isMin is a template argument so that the comparisons of the loop do not test it.
+	*/
+	template<bool isMin>
+	void pushDown(int i);
+
+	/**
+	 * @brief move a new element at index i up to its place.
+	*/
+	void pushUp(int i);
+
+	/**
+	 * @brief move an element up by grandparents, on min. levels (isMin) or on max. levels.
+	*/
+	void pushUp(int i, bool isMin);
+
+	/**
+	 * @brief check if a comes before b on a min. level (isMin) or on a max. level.
+	*/
+	bool before(T& a, T& b, bool isMin);
+};
+
+template<typename T>
+MinMaxHeap<T>::MinMaxHeap(const int capacity)
+{
+	capacity_ = capacity > 0 ? capacity : 1;
+	size_ = 0;
+	arr_ = new T[capacity_];
+}
+
+template<typename T>
+MinMaxHeap<T>::MinMaxHeap(T* arr, const int size)
+{
+	capacity_ = size > 0 ? size : 1;
+	size_ = size;
+	arr_ = new T[capacity_];
+
+	for (int i = 0; i < size; i++)
+	{
+		arr_[i] = arr[i];
+	}
+
+	// Floyd's method - fix each internal node, from the deepest one up to the root
+	for (int i = size_ / 2 - 1; i >= 0; i--)
+	{
+		pushDown(i);
+	}
+}
+
+template<typename T>
+MinMaxHeap<T>::MinMaxHeap(const DynamicArray<T>& arr)
+{
+	capacity_ = arr.capacity_ > 0 ? arr.capacity_ : 1;
+	size_ = arr.size();
+	arr_ = new T[capacity_];
+
+	for (int i = 0; i < size_; i++)
+	{
+		arr_[i] = arr.array_[i];
+	}
+
+	for (int i = size_ / 2 - 1; i >= 0; i--)
+	{
+		pushDown(i);
+	}
+}
+
+template<typename T>
+MinMaxHeap<T>::MinMaxHeap(DynamicArray<T>&& arr)
+{
+	capacity_ = arr.capacity_;
+	size_ = arr.size_;
+	arr_ = arr.array_;
+
+	// the heap owns the buffer now, the array grows from nothing if it is used again
+	arr.array_ = nullptr;
+	arr.capacity_ = 0;
+	arr.size_ = 0;
+
+	// a zero capacity buffer (delete[] of nullptr does nothing) is replaced with a real one
+	if (!arr_ || capacity_ < 1)
+	{
+		delete[] arr_;
+
+		capacity_ = 1;
+		arr_ = new T[capacity_];
+	}
+
+	for (int i = size_ / 2 - 1; i >= 0; i--)
+	{
+		pushDown(i);
+	}
+}
+
+template<typename T>
+MinMaxHeap<T>::~MinMaxHeap()
+{
+	delete[] arr_;
+
+	size_ = -1;
+}
+
+template<typename T>
+inline T MinMaxHeap<T>::minimum()
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	return arr_[0];
+}
+
+template<typename T>
+inline T MinMaxHeap<T>::maximum()
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	return arr_[maxIndex()];
+}
+
+template<typename T>
+T MinMaxHeap<T>::extractMin()
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	return removeAt(0);
+}
+
+template<typename T>
+T MinMaxHeap<T>::extractMax()
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	return removeAt(maxIndex());
+}
+
+template<typename T>
+void MinMaxHeap<T>::insert(T key)
+{
+	if (size_ == capacity_)
+	{
+		capacity_ *= GROWTH_FACTOR;
+
+		T* newArr = new T[capacity_];
+
+		for (int i = 0; i < size_; i++)
+		{
+			newArr[i] = std::move(arr_[i]);
+		}
+
+		delete[] arr_;
+
+		arr_ = newArr;
+	}
+
+	arr_[size_] = std::move(key);
+	size_++;
+
+	pushUp(size_ - 1);
+}
+
+template<typename T>
+inline int MinMaxHeap<T>::size()
+{
+	return size_;
+}
+
+template<typename T>
+inline bool MinMaxHeap<T>::isEmpty()
+{
+	return size_ == 0;
+}
+
+// PRIVATES
+
+template<typename T>
+inline bool MinMaxHeap<T>::isMinLevel(int i)
+{
+	int level = 0;
+
+	// the level is the index of the highest bit of i + 1
+	for (i++; i > 1; i >>= 1)
+	{
+		level++;
+	}
+
+	return level % 2 == 0;
+}
+
+template<typename T>
+inline int MinMaxHeap<T>::maxIndex()
+{
+	// the maximum is the root's greater child (or the root itself)
+	if (size_ == 1)
+	{
+		return 0;
+	}
+
+	if (size_ == 2 || arr_[2] < arr_[1])
+	{
+		return 1;
+	}
+
+	return 2;
+}
+
+template<typename T>
+T MinMaxHeap<T>::removeAt(int i)
+{
+	T key = std::move(arr_[i]);
+
+	size_--;
+
+	if (i < size_)
+	{
+		arr_[i] = std::move(arr_[size_]);
+		pushDown(i);
+	}
+
+	return key;
+}
+
+template<typename T>
+inline bool MinMaxHeap<T>::before(T& a, T& b, bool isMin)
+{
+	return isMin ? a < b : b < a;
+}
+
+template<typename T>
+inline void MinMaxHeap<T>::pushDown(int i)
+{
+	if (isMinLevel(i))
+	{
+		pushDown<true>(i);
+	}
+	else
+	{
+		pushDown<false>(i);
+	}
+}
+
+template<typename T>
+template<bool isMin>
+void MinMaxHeap<T>::pushDown(int i)
+{
+	while (2 * i + 1 < size_)
+	{
+		// find the first of the children and the grandchildren
+		int first = 2 * i + 1, best = first;
+
+		for (int c = first; c < first + 2 && c < size_; c++)
+		{
+			if (before(arr_[c], arr_[best], isMin))
+			{
+				best = c;
+			}
+
+			for (int g = 2 * c + 1; g < 2 * c + 3 && g < size_; g++)
+			{
+				if (before(arr_[g], arr_[best], isMin))
+				{
+					best = g;
+				}
+			}
+		}
+
+		if (!before(arr_[best], arr_[i], isMin))
+		{
+			return;
+		}
+
+		std::swap(arr_[best], arr_[i]);
+
+		// a child is on the other kind of level, and has no subtree to fix below this one
+		if (best <= first + 1)
+		{
+			return;
+		}
+
+		// the element that came down to a grandchild may not fit under its new parent
+		int parent = (best - 1) / 2;
+
+		if (before(arr_[parent], arr_[best], isMin))
+		{
+			std::swap(arr_[parent], arr_[best]);
+		}
+
+		i = best;
+	}
+}
+
+template<typename T>
+void MinMaxHeap<T>::pushUp(int i)
+{
+	if (i == 0)
+	{
+		return;
+	}
+
+	bool isMin = isMinLevel(i);
+	int parent = (i - 1) / 2;
+
+	// if the element belongs on the parent's kind of level, swap them and go up on those levels
+	if (before(arr_[parent], arr_[i], isMin))
+	{
+		std::swap(arr_[parent], arr_[i]);
+		pushUp(parent, !isMin);
+	}
+	else
+	{
+		pushUp(i, isMin);
+	}
+}
+
+template<typename T>
+void MinMaxHeap<T>::pushUp(int i, bool isMin)
+{
+	// go up by grandparents while the element comes before them
+	while (i > 2)
+	{
+		int grandparent = ((i - 1) / 2 - 1) / 2;
+
+		if (!before(arr_[i], arr_[grandparent], isMin))
+		{
+			return;
+		}
+
+		std::swap(arr_[i], arr_[grandparent]);
+		i = grandparent;
+	}
+}
@@ -0,0 +1,271 @@
+#pragma once
+
+#include "DaryHeap.h"
+#include "../Random.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+/**
+ * A relaxed concurrent priority queue (MultiQueue).
+ * The keys are spread over c * p sequential heaps, each behind its own lock: a push goes
+ * to a random heap, and a pop looks at the tops of two random heaps and takes the better one.
+ * Threads rarely wait for each other, so the throughput grows with the number of threads,
+ * but the order is relaxed: a pop does not always return the top key of the whole queue.
+ * With n = c * p heaps, the rank of a popped key (its place among all the keys in the queue)
+ * is O(n) in expectation and O(n log n) with high probability - the two-choice process keeps
+ * the heaps' tops close to each other. A larger c means less contention and larger errors.
+ * The element on top is the one that comes first by Compare (std::less gives a min. queue).
+ */
+template<typename T, typename Compare = std::less<T> >
+class MultiQueue
+{
+public:
+	/**
+	 * @brief build an empty queue.
+	 * @param threads the number of threads that use the queue (p).
+	 * @param c the number of heaps per thread.
+	 * @param compare
+	*/
+	explicit MultiQueue(int threads = defaultThreads(), int c = DEFAULT_C, Compare compare = Compare());
+
+	~MultiQueue();
+
+	MultiQueue(const MultiQueue& other) = delete;
+
+	MultiQueue& operator=(const MultiQueue& other) = delete;
+
+	/**
+	 * @brief insert a new key to a random heap.
+	 * @param key
+	*/
+	void push(T key);
+
+	/**
+	 * @brief pop a key that is close to the top (see the rank bounds above).
+	 * @param key gets the popped key.
+	 * @return false iff the queue was empty.
+	*/
+	bool tryPopMin(T& key);
+
+	/**
+	 * @brief get the number of keys (exact only when no update is running).
+	*/
+	int size() const;
+
+	bool isEmpty() const;
+
+private:
+	/** A heap and its lock, padded so that two heaps never share a cache line. */
+	struct Shard
+	{
+		std::mutex lock;
+		DaryHeap<T, 4, Compare> heap;
+		char padding[64];
+
+		explicit Shard(Compare compare) : heap(16, compare)
+		{
+		}
+	};
+
+	static const int DEFAULT_C = 2;
+
+	// the number of two-choice pops that find both heaps empty before checking all of them
+	static const int EMPTY_TRIES = 8;
+
+	Shard** shards_;
+	int count_;
+
+	std::atomic<int> size_;
+
+	Compare compare_;
+
+	static int defaultThreads();
+
+	/**
+	 * @brief get the random generator of the calling thread.
+	*/
+	static FastRandom& random();
+
+	/**
+	 * @brief lock a random heap that no other thread holds.
+	 * @return its index.
+	*/
+	int lockRandom();
+
+	/**
+	 * @brief pop the top of some non-empty heap, checking every heap in turn.
+	 * @return false iff all the heaps were empty.
+	*/
+	bool popAny(T& key);
+};
+
+template<typename T, typename Compare>
+MultiQueue<T, Compare>::MultiQueue(int threads, int c, Compare compare) : compare_(compare)
+{
+	if (threads < 1 || c < 1)
+	{
+		throw std::invalid_argument("the number of threads and c should be positive");
+	}
+
+	// two heaps at least, for the two choices
+	count_ = threads * c > 1 ? threads * c : 2;
+
+	shards_ = new Shard*[count_];
+
+	for (int i = 0; i < count_; i++)
+	{
+		shards_[i] = new Shard(compare);
+	}
+
+	size_.store(0);
+}
+
+template<typename T, typename Compare>
+MultiQueue<T, Compare>::~MultiQueue()
+{
+	for (int i = 0; i < count_; i++)
+	{
+		delete shards_[i];
+	}
+
+	delete[] shards_;
+
+	shards_ = nullptr;
+	count_ = 0;
+}
+
+template<typename T, typename Compare>
+void MultiQueue<T, Compare>::push(T key)
+{
+	int i = lockRandom();
+
+	shards_[i]->heap.insert(std::move(key));
+
+	// count the key before another thread can pop it, so size_ never drops below the keys left
+	size_++;
+
+	shards_[i]->lock.unlock();
+}
+
+template<typename T, typename Compare>
+bool MultiQueue<T, Compare>::tryPopMin(T& key)
+{
+	int emptyTries = 0;
+
+	while (size_.load() > 0)
+	{
+		// two random heaps, the second one is skipped if another thread holds it
+		int i = lockRandom(), j = (int)random().below(count_);
+
+		Shard* first = shards_[i], * second = nullptr;
+
+		if (j != i && shards_[j]->lock.try_lock())
+		{
+			second = shards_[j];
+		}
+
+		// take the better top of the two
+		Shard* best = first;
+
+		if (second && !second->heap.isEmpty() &&
+			(first->heap.isEmpty() || compare_(second->heap.top(), first->heap.top())))
+		{
+			best = second;
+		}
+
+		bool popped = !best->heap.isEmpty();
+
+		if (popped)
+		{
+			key = best->heap.extractTop();
+		}
+
+		first->lock.unlock();
+
+		if (second)
+		{
+			second->lock.unlock();
+		}
+
+		if (popped)
+		{
+			size_--;
+			return true;
+		}
+
+		// the keys may be in a few heaps only, look for them one by one
+		if (++emptyTries == EMPTY_TRIES)
+		{
+			return popAny(key);
+		}
+	}
+
+	return false;
+}
+
+template<typename T, typename Compare>
+inline int MultiQueue<T, Compare>::size() const
+{
+	return size_.load();
+}
+
+template<typename T, typename Compare>
+inline bool MultiQueue<T, Compare>::isEmpty() const
+{
+	return size() == 0;
+}
+
+// PRIVATES
+
+template<typename T, typename Compare>
+int MultiQueue<T, Compare>::defaultThreads()
+{
+	int threads = (int)std::thread::hardware_concurrency();
+
+	return threads > 0 ? threads : 1;
+}
+
+template<typename T, typename Compare>
+FastRandom& MultiQueue<T, Compare>::random()
+{
+	static thread_local FastRandom random;
+
+	return random;
+}
+
+template<typename T, typename Compare>
+int MultiQueue<T, Compare>::lockRandom()
+{
+	while (true)
+	{
+		int i = (int)random().below(count_);
+
+		if (shards_[i]->lock.try_lock())
+		{
+			return i;
+		}
+	}
+}
+
+template<typename T, typename Compare>
+bool MultiQueue<T, Compare>::popAny(T& key)
+{
+	for (int i = 0; i < count_; i++)
+	{
+		std::lock_guard<std::mutex> guard(shards_[i]->lock);
+
+		if (!shards_[i]->heap.isEmpty())
+		{
+			key = shards_[i]->heap.extractTop();
+			size_--;
+
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,530 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * A pairing heap: a meldable heap kept as a multiway tree, where each node points to its
+ * first child and its next sibling.
+ * insert, meld and top are O(1), extractTop and erase are amortized O(log n), and
+ * decreaseKey is amortized o(log n).
+ * The element on top is the one that comes first by Compare (std::less gives a min. heap).
+ * insert returns a handle to the key's node, which stays valid until the key leaves the heap
+ * (also across a meld into another heap).
+ * The nodes come from a pool of blocks owned by the heap; a meld hands the other heap's
+ * blocks over to this one, so it does not copy or reallocate anything.
+ */
+template<typename T, typename Compare = std::less<T> >
+class PairingHeap
+{
+	class Node;
+
+public:
+	/** A handle to a key in the heap. */
+	typedef Node* Handle;
+
+	// Constructors
+
+	explicit PairingHeap(Compare compare = Compare());
+
+	~PairingHeap();
+
+	PairingHeap(const PairingHeap& other) = delete;
+
+	PairingHeap& operator=(const PairingHeap& other) = delete;
+
+	// Operations
+
+	/**
+	 * @brief insert a new key to the heap.
+	 * @param key
+	 * @return the key's handle.
+	*/
+	Handle insert(T key);
+
+	/**
+	 * @brief get the key on top of the heap and keep it in the heap.
+	*/
+	const T& top() const;
+
+	/**
+	 * @brief get the key on top of the heap and pop it out.
+	*/
+	T extractTop();
+
+	/**
+	 * @brief get the key of a handle.
+	*/
+	const T& get(Handle handle) const;
+
+	/**
+	 * @brief move a key towards the top: the new key must not come after the current one.
+	 * @param handle
+	 * @param key
+	*/
+	void decreaseKey(Handle handle, T key);
+
+	/**
+	 * @brief remove the key of a handle from the heap.
+	 * @param handle
+	*/
+	void erase(Handle handle);
+
+	/**
+	 * @brief move all the keys of another heap into this heap in O(1).
+	 * the other heap is left empty, and the handles to its keys now belong to this heap.
+	 * @param other
+	*/
+	void meld(PairingHeap& other);
+
+	// Getters
+
+	int size() const;
+
+	bool isEmpty() const;
+
+private:
+	class Node
+	{
+	private:
+		friend class PairingHeap<T, Compare>;
+
+		T key_;
+		Node* child_;
+		Node* sibling_;
+
+		// the previous sibling, or the parent for a first child (nullptr for the root)
+		Node* prev_;
+
+		explicit Node(T key) : key_(std::move(key)), child_(nullptr), sibling_(nullptr), prev_(nullptr)
+		{
+		}
+	};
+
+	/** A slot in the pool that holds no node, it links to the next free slot. */
+	struct FreeSlot
+	{
+		FreeSlot* next;
+	};
+
+	/** The header of a block of slots. */
+	struct Block
+	{
+		Block* next;
+	};
+
+	static const int BLOCK_SIZE = 64;
+
+	Node* root_;
+
+	int size_;
+
+	Compare compare_;
+
+	// the pool: its blocks and its free slots (with their last ones, to hand them over in O(1))
+	Block* blocks_;
+	Block* lastBlock_;
+	FreeSlot* free_;
+	FreeSlot* lastFree_;
+
+	// Pool
+
+	static size_t slotsOffset();
+
+	Node* allocate(T key);
+
+	void release(Node* node);
+
+	// Tree
+
+	/**
+	 * @brief make the root that comes later the first child of the other one.
+	 * @return the new root.
+	*/
+	Node* link(Node* a, Node* b);
+
+	/**
+	 * @brief detach a node (and its subtree) from its parent and siblings.
+	*/
+	void cut(Node* node);
+
+	/**
+	 * @brief merge a list of siblings into one tree: pair them left to right,
+	 * then link the pairs right to left.
+	 * @return the new root (nullptr for an empty list).
+	*/
+	Node* combine(Node* first);
+};
+
+// Constructors
+
+template<typename T, typename Compare>
+PairingHeap<T, Compare>::PairingHeap(Compare compare) : compare_(compare)
+{
+	root_ = nullptr;
+	size_ = 0;
+
+	blocks_ = nullptr;
+	lastBlock_ = nullptr;
+	free_ = nullptr;
+	lastFree_ = nullptr;
+}
+
+template<typename T, typename Compare>
+PairingHeap<T, Compare>::~PairingHeap()
+{
+	Node* stack = root_, * node = nullptr;
+
+	// destroy the keys: the siblings chain is a stack, a node's children are pushed on it
+	while (stack)
+	{
+		node = stack;
+		stack = node->sibling_;
+
+		if (node->child_)
+		{
+			Node* last = node->child_;
+
+			while (last->sibling_)
+			{
+				last = last->sibling_;
+			}
+
+			last->sibling_ = stack;
+			stack = node->child_;
+		}
+
+		node->~Node();
+	}
+
+	while (blocks_)
+	{
+		Block* next = blocks_->next;
+		::operator delete(blocks_);
+		blocks_ = next;
+	}
+
+	root_ = nullptr;
+	size_ = 0;
+}
+
+// Operations
+
+template<typename T, typename Compare>
+typename PairingHeap<T, Compare>::Handle PairingHeap<T, Compare>::insert(T key)
+{
+	Node* node = allocate(std::move(key));
+
+	root_ = root_ ? link(root_, node) : node;
+	size_++;
+
+	return node;
+}
+
+template<typename T, typename Compare>
+inline const T& PairingHeap<T, Compare>::top() const
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	return root_->key_;
+}
+
+template<typename T, typename Compare>
+T PairingHeap<T, Compare>::extractTop()
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	Node* oldRoot = root_;
+	T key = std::move(oldRoot->key_);
+
+	root_ = combine(oldRoot->child_);
+
+	release(oldRoot);
+	size_--;
+
+	return key;
+}
+
+template<typename T, typename Compare>
+inline const T& PairingHeap<T, Compare>::get(Handle handle) const
+{
+	return handle->key_;
+}
+
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::decreaseKey(Handle handle, T key)
+{
+	if (compare_(handle->key_, key))
+	{
+		throw std::logic_error("the new key comes after the original key");
+	}
+
+	handle->key_ = std::move(key);
+
+	// the subtree of the node is still a heap, link it to the root
+	if (handle != root_)
+	{
+		cut(handle);
+		root_ = link(root_, handle);
+	}
+}
+
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::erase(Handle handle)
+{
+	if (handle == root_)
+	{
+		extractTop();
+		return;
+	}
+
+	cut(handle);
+
+	Node* children = combine(handle->child_);
+
+	if (children)
+	{
+		root_ = link(root_, children);
+	}
+
+	release(handle);
+	size_--;
+}
+
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::meld(PairingHeap& other)
+{
+	if (&other == this)
+	{
+		return;
+	}
+
+	if (other.root_)
+	{
+		root_ = root_ ? link(root_, other.root_) : other.root_;
+	}
+
+	size_ += other.size_;
+
+	// take the other heap's blocks and free slots
+	if (other.blocks_)
+	{
+		if (blocks_)
+		{
+			lastBlock_->next = other.blocks_;
+		}
+		else
+		{
+			blocks_ = other.blocks_;
+		}
+
+		lastBlock_ = other.lastBlock_;
+	}
+
+	if (other.free_)
+	{
+		if (free_)
+		{
+			lastFree_->next = other.free_;
+		}
+		else
+		{
+			free_ = other.free_;
+		}
+
+		lastFree_ = other.lastFree_;
+	}
+
+	other.root_ = nullptr;
+	other.size_ = 0;
+	other.blocks_ = nullptr;
+	other.lastBlock_ = nullptr;
+	other.free_ = nullptr;
+	other.lastFree_ = nullptr;
+}
+
+// Getters
+
+template<typename T, typename Compare>
+inline int PairingHeap<T, Compare>::size() const
+{
+	return size_;
+}
+
+template<typename T, typename Compare>
+inline bool PairingHeap<T, Compare>::isEmpty() const
+{
+	return size_ == 0;
+}
+
+// PRIVATES
+
+template<typename T, typename Compare>
+inline size_t PairingHeap<T, Compare>::slotsOffset()
+{
+	return (sizeof(Block) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+}
+
+template<typename T, typename Compare>
+typename PairingHeap<T, Compare>::Node* PairingHeap<T, Compare>::allocate(T key)
+{
+	// take a new block and put all its slots in the free list
+	if (!free_)
+	{
+		char* memory = static_cast<char*>(::operator new(slotsOffset() + BLOCK_SIZE * sizeof(Node)));
+		Block* block = new (memory) Block();
+
+		block->next = blocks_;
+		blocks_ = block;
+
+		if (!lastBlock_)
+		{
+			lastBlock_ = block;
+		}
+
+		for (int i = BLOCK_SIZE - 1; i >= 0; i--)
+		{
+			FreeSlot* slot = new (memory + slotsOffset() + i * sizeof(Node)) FreeSlot();
+
+			slot->next = free_;
+			free_ = slot;
+
+			if (!lastFree_)
+			{
+				lastFree_ = slot;
+			}
+		}
+	}
+
+	FreeSlot* slot = free_;
+
+	free_ = slot->next;
+
+	if (!free_)
+	{
+		lastFree_ = nullptr;
+	}
+
+	return new (slot) Node(std::move(key));
+}
+
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::release(Node* node)
+{
+	node->~Node();
+
+	FreeSlot* slot = new (node) FreeSlot();
+
+	slot->next = free_;
+	free_ = slot;
+
+	if (!lastFree_)
+	{
+		lastFree_ = slot;
+	}
+}
+
+template<typename T, typename Compare>
+typename PairingHeap<T, Compare>::Node* PairingHeap<T, Compare>::link(Node* a, Node* b)
+{
+	if (compare_(b->key_, a->key_))
+	{
+		std::swap(a, b);
+	}
+
+	// b becomes the first child of a
+	b->sibling_ = a->child_;
+	b->prev_ = a;
+
+	if (a->child_)
+	{
+		a->child_->prev_ = b;
+	}
+
+	a->child_ = b;
+
+	return a;
+}
+
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::cut(Node* node)
+{
+	if (node->prev_->child_ == node)
+	{
+		node->prev_->child_ = node->sibling_;
+	}
+	else
+	{
+		node->prev_->sibling_ = node->sibling_;
+	}
+
+	if (node->sibling_)
+	{
+		node->sibling_->prev_ = node->prev_;
+	}
+
+	node->prev_ = nullptr;
+	node->sibling_ = nullptr;
+}
+
+template<typename T, typename Compare>
+typename PairingHeap<T, Compare>::Node* PairingHeap<T, Compare>::combine(Node* first)
+{
+	if (!first)
+	{
+		return nullptr;
+	}
+
+	Node* pairs = nullptr, * a = nullptr, * b = nullptr;
+
+	// first pass: link the siblings in pairs, and stack the results (the last pair on top)
+	while (first)
+	{
+		a = first;
+		b = a->sibling_;
+		first = b ? b->sibling_ : nullptr;
+
+		a->prev_ = nullptr;
+		a->sibling_ = nullptr;
+
+		if (b)
+		{
+			b->prev_ = nullptr;
+			b->sibling_ = nullptr;
+
+			a = link(a, b);
+		}
+
+		a->sibling_ = pairs;
+		pairs = a;
+	}
+
+	// second pass: link the pairs from the last to the first
+	Node* root = pairs;
+
+	pairs = pairs->sibling_;
+	root->sibling_ = nullptr;
+
+	while (pairs)
+	{
+		Node* next = pairs->sibling_;
+
+		pairs->sibling_ = nullptr;
+		root = link(root, pairs);
+
+		pairs = next;
+	}
+
+	root->prev_ = nullptr;
+
+	return root;
+}
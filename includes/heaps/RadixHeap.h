@@ -0,0 +1,230 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include "../lists/DynamicArray.h"
+
+/**
+ * A radix heap: a minimum heap for monotone unsigned keys (a key is never smaller than the
+ * last extracted minimum), as in Dijkstra's algorithm or in event simulation.
+ * Bucket b > 0 holds the keys whose highest bit that differs from the last minimum is bit b - 1,
+ * and bucket 0 holds the keys equal to it. When bucket 0 runs out, the first non-empty bucket
+ * is spread over the lower buckets around its minimum - each key only moves down, at most 64
+ * times, so the operations are O(1) amortized (O(log C) for keys up to C), with no comparisons
+ * of pairs of keys.
+ * Every key carries a value (for example a vertex).
+ */
+template<typename V = int>
+class RadixHeap
+{
+public:
+	RadixHeap();
+
+	/**
+	 * @brief insert a new key to the heap.
+	 * @param key not smaller than the last extracted key.
+	 * @param value
+	*/
+	void insert(uint64_t key, V value = V());
+
+	/**
+	 * @brief get the minimum key in the heap and keep it in the heap.
+	*/
+	uint64_t minimum();
+
+	/**
+	 * @brief get the minimum key in the heap and pop it out.
+	*/
+	uint64_t extractMin();
+
+	/**
+	 * @brief get the minimum key in the heap and pop it out.
+	 * @param value gets the key's value.
+	*/
+	uint64_t extractMin(V& value);
+
+	int size();
+
+	bool isEmpty();
+
+private:
+	/** A key and its value. */
+	struct Entry
+	{
+		uint64_t key;
+		V value;
+
+		Entry()
+		{
+			key = 0;
+		}
+
+		Entry(uint64_t k, V v)
+		{
+			key = k;
+			value = v;
+		}
+
+		bool operator==(const Entry& other) const
+		{
+			return key == other.key && value == other.value;
+		}
+
+		bool operator!=(const Entry& other) const
+		{
+			return !operator==(other);
+		}
+	};
+
+	static const int BUCKETS = 65;
+
+	DynamicArray<Entry> buckets_[BUCKETS];
+
+	// the last extracted minimum
+	uint64_t last_;
+
+	int size_;
+
+	/**
+	 * @brief get the bucket of a key, relative to the last minimum.
+	*/
+	int bucketOf(uint64_t key);
+
+	/**
+	 * @brief make sure bucket 0 holds the minimum, by spreading the first non-empty bucket.
+	*/
+	void refill();
+};
+
+template<typename V>
+RadixHeap<V>::RadixHeap()
+{
+	last_ = 0;
+	size_ = 0;
+}
+
+template<typename V>
+void RadixHeap<V>::insert(uint64_t key, V value)
+{
+	if (key < last_)
+	{
+		throw std::invalid_argument("the key is smaller than the last extracted key");
+	}
+
+	buckets_[bucketOf(key)].add(Entry(key, value));
+	size_++;
+}
+
+template<typename V>
+uint64_t RadixHeap<V>::minimum()
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	refill();
+
+	return last_;
+}
+
+template<typename V>
+uint64_t RadixHeap<V>::extractMin()
+{
+	V value;
+
+	return extractMin(value);
+}
+
+template<typename V>
+uint64_t RadixHeap<V>::extractMin(V& value)
+{
+	if (isEmpty())
+	{
+		throw std::underflow_error("this heap is empty");
+	}
+
+	refill();
+
+	value = buckets_[0].removeLast().value;
+	size_--;
+
+	return last_;
+}
+
+template<typename V>
+inline int RadixHeap<V>::size()
+{
+	return size_;
+}
+
+template<typename V>
+inline bool RadixHeap<V>::isEmpty()
+{
+	return size_ == 0;
+}
+
+// PRIVATES
+
+template<typename V>
+inline int RadixHeap<V>::bucketOf(uint64_t key)
+{
+	uint64_t diff = key ^ last_;
+
+	if (diff == 0)
+	{
+		return 0;
+	}
+
+#if defined(__GNUC__) || defined(__clang__)
+	return 64 - __builtin_clzll(diff);
+#else
+	int bucket = 0;
+
+	while (diff)
+	{
+		diff >>= 1;
+		bucket++;
+	}
+
+	return bucket;
+#endif
+}
+
+template<typename V>
+void RadixHeap<V>::refill()
+{
+	if (!buckets_[0].isEmpty())
+	{
+		return;
+	}
+
+	int b = 1;
+
+	while (buckets_[b].isEmpty())
+	{
+		b++;
+	}
+
+	DynamicArray<Entry>& bucket = buckets_[b];
+
+	// the new minimum, all the keys of the bucket fall in lower buckets around it
+	uint64_t min = bucket[0].key;
+
+	for (int i = 1; i < bucket.size(); i++)
+	{
+		if (bucket[i].key < min)
+		{
+			min = bucket[i].key;
+		}
+	}
+
+	last_ = min;
+
+	while (!bucket.isEmpty())
+	{
+		Entry entry = bucket.removeLast();
+
+		buckets_[bucketOf(entry.key)].add(entry);
+	}
+}
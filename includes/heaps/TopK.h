@@ -0,0 +1,238 @@
+#pragma once
+
+#include "DaryHeap.h"
+#include "../lists/DynamicArray.h"
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+/**
+ * The K last keys of a stream by Compare (with std::less - the K largest keys).
+ * The kept keys are in a heap of size K whose top is the first of them - the threshold a new
+ * key has to beat. Most keys of a long stream do not beat it, so they cost one comparison.
+ * The memory is O(K) however long the stream is.
+ * Instances filled by different threads can be merged into one.
+ */
+template<typename T, typename Compare = std::less<T> >
+class TopK
+{
+public:
+	/**
+	 * @brief build an empty selection.
+	 * @param k the number of keys to keep.
+	 * @param compare
+	*/
+	explicit TopK(int k, Compare compare = Compare());
+
+	~TopK();
+
+	TopK(const TopK& other) = delete;
+
+	TopK& operator=(const TopK& other) = delete;
+
+	/**
+	 * @brief offer a key from the stream.
+	 * @param key
+	*/
+	void push(T key);
+
+	/**
+	 * @brief offer a batch of keys from the stream.
+	 * the batch is first filtered against the threshold without branches, then the
+	 * few keys that pass are pushed one by one.
+	 * @param keys
+	 * @param n the number of keys.
+	*/
+	void pushMany(const T* keys, int n);
+
+	/**
+	 * @brief offer all the keys kept by another selection.
+	 * @param other
+	*/
+	void merge(const TopK& other);
+
+	/**
+	 * @brief merge selections in a tree of rounds, each round merging pairs on separate threads.
+	 * @param parts the selections, the result is in parts[0] and the others are left as they were or merged.
+	 * @param count the number of selections.
+	*/
+	static void mergeAll(TopK** parts, int count);
+
+	/**
+	 * @brief get the kept keys, from the last by Compare (the best) to the first.
+	*/
+	DynamicArray<T> result() const;
+
+	/**
+	 * @brief get the key a new key has to beat (the first of the kept keys).
+	*/
+	const T& threshold() const;
+
+	// Getters
+
+	int k() const;
+
+	int size() const;
+
+	bool isFull() const;
+
+private:
+	static const int BATCH = 256;
+
+	int k_;
+
+	DaryHeap<T, 4, Compare> heap_;
+
+	Compare compare_;
+
+	// the keys of a batch that passed the filter
+	T* candidates_;
+};
+
+template<typename T, typename Compare>
+TopK<T, Compare>::TopK(int k, Compare compare) : heap_(k > 0 ? k : 1, compare), compare_(compare)
+{
+	if (k < 0)
+	{
+		throw std::invalid_argument("k cannot be negative");
+	}
+
+	k_ = k;
+	candidates_ = new T[BATCH];
+}
+
+template<typename T, typename Compare>
+TopK<T, Compare>::~TopK()
+{
+	delete[] candidates_;
+
+	candidates_ = nullptr;
+}
+
+template<typename T, typename Compare>
+void TopK<T, Compare>::push(T key)
+{
+	if (heap_.size() < k_)
+	{
+		heap_.insert(std::move(key));
+	}
+	// the key beats the threshold, it takes its place
+	else if (k_ > 0 && compare_(heap_.top(), key))
+	{
+		heap_.replaceTop(std::move(key));
+	}
+}
+
+template<typename T, typename Compare>
+void TopK<T, Compare>::pushMany(const T* keys, int n)
+{
+	int i = 0;
+
+	// until the heap is full there is nothing to filter against
+	while (i < n && heap_.size() < k_)
+	{
+		push(keys[i++]);
+	}
+
+	if (k_ == 0)
+	{
+		return;
+	}
+
+	while (i < n)
+	{
+		// the threshold only rises, so a stale copy lets through a few extra keys that push rejects
+		T threshold = heap_.top();
+		int end = n - i < BATCH ? n : i + BATCH, count = 0;
+
+		for (; i < end; i++)
+		{
+			candidates_[count] = keys[i];
+			count += compare_(threshold, keys[i]) ? 1 : 0;
+		}
+
+		for (int j = 0; j < count; j++)
+		{
+			push(std::move(candidates_[j]));
+		}
+	}
+}
+
+template<typename T, typename Compare>
+void TopK<T, Compare>::merge(const TopK& other)
+{
+	if (&other != this)
+	{
+		pushMany(other.heap_.data(), other.heap_.size());
+	}
+}
+
+template<typename T, typename Compare>
+void TopK<T, Compare>::mergeAll(TopK** parts, int count)
+{
+	// in each round, part i takes part i + step, for every i that is a multiple of 2 * step
+	for (int step = 1; step < count; step *= 2)
+	{
+		DynamicArray<std::thread*> threads;
+
+		for (int i = 0; i + step < count; i += 2 * step)
+		{
+			TopK* into = parts[i], * from = parts[i + step];
+
+			threads.add(new std::thread([into, from]() { into->merge(*from); }));
+		}
+
+		for (int t = 0; t < threads.size(); t++)
+		{
+			threads[t]->join();
+			delete threads[t];
+		}
+	}
+}
+
+template<typename T, typename Compare>
+DynamicArray<T> TopK<T, Compare>::result() const
+{
+	int n = heap_.size();
+
+	DaryHeap<T, 4, Compare> copy(heap_.data(), n, compare_);
+	DynamicArray<T> keys(n > 0 ? n : 1);
+
+	for (int i = 0; i < n; i++)
+	{
+		keys.add(T());
+	}
+
+	// the heap pops from the first to the last, fill from the end
+	for (int i = n - 1; i >= 0; i--)
+	{
+		keys[i] = copy.extractTop();
+	}
+
+	return keys;
+}
+
+template<typename T, typename Compare>
+inline const T& TopK<T, Compare>::threshold() const
+{
+	return heap_.top();
+}
+
+template<typename T, typename Compare>
+inline int TopK<T, Compare>::k() const
+{
+	return k_;
+}
+
+template<typename T, typename Compare>
+inline int TopK<T, Compare>::size() const
+{
+	return heap_.size();
+}
+
+template<typename T, typename Compare>
+inline bool TopK<T, Compare>::isFull() const
+{
+	return heap_.size() == k_;
+}
@@ -2,6 +2,7 @@
 
 #include "List.h"
 #include <stdexcept>
+#include <utility>
 
 template<typename T>
 class DynamicArray : public List<T>
@@ -13,6 +14,12 @@ public:
 
     explicit DynamicArray(int initCapacity);
 
+    /** copy the items of another array. */
+    DynamicArray(const DynamicArray<T>& other);
+
+    /** take the buffer of another array, which is left empty (without a buffer). */
+    DynamicArray(DynamicArray<T>&& other);
+
     ~DynamicArray();
 
     /** get the capacity of the array (not its getSize!) */
@@ -53,6 +60,10 @@ public:
 
     template <typename E> friend class Sort;
 
+    // the heaps adopt and give back the buffer without copying it
+    template <typename E, typename C> friend class BinaryHeap;
+    template <typename E> friend class MinMaxHeap;
+
 private:
     int capacity_;
     T* array_;
@@ -77,7 +88,7 @@ void DynamicArray<T>::clear(bool shrink)
         capacity_ = oldCapacity;
     }
 
-    delete array_;
+    delete[] array_;
     array_ = new T[capacity_];
     this->size_ = 0;
 }
@@ -208,7 +219,7 @@ void DynamicArray<T>::add(T item, int index)
         expand();
     }
 
-    for (int i = this->size_; i != index - 1; i--)
+    for (int i = this->size_; i > index; i--)
     {
         array_[i] = array_[i - 1];
     }
@@ -232,13 +243,21 @@ void DynamicArray<T>::add(T item)
 template<typename T>
 void DynamicArray<T>::expand()
 {
+    int oldCapacity = capacity_;
+
     capacity_ *= GROWTH_FACTOR;
 
+    // small capacities do not grow by the factor alone
+    if (capacity_ <= oldCapacity)
+    {
+        capacity_ = oldCapacity + 1;
+    }
+
     T* newArray = new T[capacity_];
 
     for (int i = 0; i < this->size_; i++)
     {
-        newArray[i] = array_[i];
+        newArray[i] = std::move(array_[i]);
     }
 
     delete[] array_;
@@ -249,7 +268,7 @@ void DynamicArray<T>::expand()
 template<typename T>
 DynamicArray<T>::~DynamicArray()
 {
-    delete array_;
+    delete[] array_;
     array_ = nullptr;
     capacity_ = 0;
     this->size_ = 0;
@@ -263,6 +282,32 @@ DynamicArray<T>::DynamicArray(int initCapacity)
     array_ = new T[capacity_];
 }
 
+template<typename T>
+DynamicArray<T>::DynamicArray(const DynamicArray<T>& other)
+{
+    this->size_ = other.size_;
+    capacity_ = other.capacity_;
+    array_ = new T[capacity_];
+
+    for (int i = 0; i < this->size_; i++)
+    {
+        array_[i] = other.array_[i];
+    }
+}
+
+template<typename T>
+DynamicArray<T>::DynamicArray(DynamicArray<T>&& other)
+{
+    this->size_ = other.size_;
+    capacity_ = other.capacity_;
+    array_ = other.array_;
+
+    // the other array grows from nothing if it is used again
+    other.size_ = 0;
+    other.capacity_ = 0;
+    other.array_ = nullptr;
+}
+
 template<typename T>
 DynamicArray<T>::DynamicArray()
 {
@@ -0,0 +1,354 @@
+#pragma once
+
+#include "List.h"
+#include <stdexcept>
+
+/** A list kept in one array with a movable gap (free space) inside it.
+ * The gap follows the last edit, so inserting or removing near the previous edit
+ * costs O(1) amortized, and moving the gap by d positions costs O(d). */
+template<typename T>
+class GapBuffer : public List<T>
+{
+public:
+    GapBuffer();
+
+    explicit GapBuffer(int initCapacity);
+
+    GapBuffer(T* arr, int len);
+
+    ~GapBuffer();
+
+    GapBuffer(const GapBuffer<T>& other) = delete;
+
+    GapBuffer<T>& operator=(const GapBuffer<T>& other) = delete;
+
+    /** get the capacity of the buffer (not its size!) */
+    int capacity()
+    {
+        return capacity_;
+    };
+
+    /** get the position of the gap, i.e. the index where the next local insertion happens. */
+    int cursor() const;
+
+    /** move the gap to a given index (0 to size). */
+    void moveCursor(int index);
+
+    /** add an item to the end of the list. */
+    void add(T item);
+
+    /** add an item to the list in a specific index. */
+    void add(T item, int index);
+
+    /** insert an item at the cursor and move the cursor after it. */
+    void insert(T item);
+
+    /** remove the item right before the cursor (like backspace).
+     * @return the removed item. */
+    T erase();
+
+    /** set the item in a given index to a new value. returns the old value. */
+    T set(int index, T item);
+
+    /** get the item in the given index. */
+    T get(int index) const;
+
+    /** get a reference to the item in the given index. */
+    T& operator[](int index);
+
+    /** remove an item from the list. */
+    bool remove(T item);
+
+    T removeAt(int index);
+
+    T removeFirst();
+
+    T removeLast();
+
+    /** check if an item is in the list. */
+    bool contains(T item) const;
+
+private:
+    int capacity_;
+    T* buffer_;
+    int gapStart_;      // the first free cell
+    int gapEnd_;        // the first used cell after the gap
+    const int DEFAULT_CAPACITY = 16;
+    const float GROWTH_FACTOR = 1.5;
+
+    /** translate a list index to a position in the buffer. */
+    int position(int index) const;
+
+    /** expand the buffer, the gap grows and the elements after it move to the end. */
+    void expand();
+};
+
+template<typename T>
+GapBuffer<T>::GapBuffer()
+{
+    this->size_ = 0;
+    capacity_ = DEFAULT_CAPACITY;
+    buffer_ = new T[capacity_];
+    gapStart_ = 0;
+    gapEnd_ = capacity_;
+}
+
+template<typename T>
+GapBuffer<T>::GapBuffer(int initCapacity)
+{
+    if (initCapacity <= 0)
+    {
+        throw std::invalid_argument("initial capacity should be a positive number");
+    }
+
+    this->size_ = 0;
+    capacity_ = initCapacity;
+    buffer_ = new T[capacity_];
+    gapStart_ = 0;
+    gapEnd_ = capacity_;
+}
+
+template<typename T>
+GapBuffer<T>::GapBuffer(T* arr, int len)
+{
+    this->size_ = len;
+    capacity_ = len > 0 ? len : DEFAULT_CAPACITY;
+    buffer_ = new T[capacity_];
+
+    for (int i = 0; i < len; i++)
+    {
+        buffer_[i] = arr[i];
+    }
+
+    // the gap is empty and placed at the end
+    gapStart_ = len;
+    gapEnd_ = capacity_;
+}
+
+template<typename T>
+GapBuffer<T>::~GapBuffer()
+{
+    delete[] buffer_;
+    buffer_ = nullptr;
+    capacity_ = 0;
+    this->size_ = 0;
+}
+
+template<typename T>
+inline int GapBuffer<T>::cursor() const
+{
+    return gapStart_;
+}
+
+template<typename T>
+void GapBuffer<T>::moveCursor(int index)
+{
+    if (index < 0 || index > this->size_)
+    {
+        throw std::out_of_range("got illegal index");
+    }
+
+    // move the elements between the new position and the gap to the other side of the gap
+
+    while (gapStart_ > index)
+    {
+        buffer_[--gapEnd_] = buffer_[--gapStart_];
+    }
+
+    while (gapStart_ < index)
+    {
+        buffer_[gapStart_++] = buffer_[gapEnd_++];
+    }
+}
+
+template<typename T>
+void GapBuffer<T>::add(T item)
+{
+    add(item, this->size_);
+}
+
+template<typename T>
+void GapBuffer<T>::add(T item, int index)
+{
+    if (index < 0 || index > this->size_)
+    {
+        throw std::out_of_range("cannot insert out of the array");
+    }
+
+    moveCursor(index);
+    insert(item);
+}
+
+template<typename T>
+void GapBuffer<T>::insert(T item)
+{
+    if (gapStart_ == gapEnd_)
+    {
+        expand();
+    }
+
+    buffer_[gapStart_++] = item;
+    this->size_++;
+}
+
+template<typename T>
+T GapBuffer<T>::erase()
+{
+    if (gapStart_ == 0)
+    {
+        throw std::underflow_error("nothing before the cursor");
+    }
+
+    // the item joins the gap
+    this->size_--;
+
+    return buffer_[--gapStart_];
+}
+
+template<typename T>
+T GapBuffer<T>::set(int index, T item)
+{
+    T& cell = operator[](index);
+    T old = cell;
+    cell = item;
+    return old;
+}
+
+template<typename T>
+T GapBuffer<T>::get(int index) const
+{
+    if (index < 0 || index >= this->size_)
+    {
+        throw std::out_of_range("got illegal index");
+    }
+
+    return buffer_[position(index)];
+}
+
+template<typename T>
+T& GapBuffer<T>::operator[](int index)
+{
+    if (index < 0 || index >= this->size_)
+    {
+        throw std::out_of_range("got illegal index");
+    }
+
+    return buffer_[position(index)];
+}
+
+template<typename T>
+bool GapBuffer<T>::remove(T item)
+{
+    int i = 0;
+
+    while (i < this->size_ && buffer_[position(i)] != item)
+    {
+        i++;
+    }
+
+    // the item is not in the buffer
+    if (i == this->size_)
+    {
+        return false;
+    }
+
+    removeAt(i);
+
+    return true;
+}
+
+template<typename T>
+T GapBuffer<T>::removeAt(int index)
+{
+    if (index < 0 || index >= this->size_)
+    {
+        throw std::out_of_range("got illegal index");
+    }
+
+    // put the item right after the gap, then let the gap swallow it
+    moveCursor(index);
+    this->size_--;
+
+    return buffer_[gapEnd_++];
+}
+
+template<typename T>
+T GapBuffer<T>::removeFirst()
+{
+    if (this->isEmpty())
+    {
+        throw std::underflow_error("this list is empty");
+    }
+
+    return removeAt(0);
+}
+
+template<typename T>
+T GapBuffer<T>::removeLast()
+{
+    if (this->isEmpty())
+    {
+        throw std::underflow_error("this list is empty");
+    }
+
+    return removeAt(this->size_ - 1);
+}
+
+template<typename T>
+bool GapBuffer<T>::contains(T item) const
+{
+    for (int i = 0; i < gapStart_; i++)
+    {
+        if (buffer_[i] == item)
+        {
+            return true;
+        }
+    }
+
+    for (int i = gapEnd_; i < capacity_; i++)
+    {
+        if (buffer_[i] == item)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template<typename T>
+inline int GapBuffer<T>::position(int index) const
+{
+    return index < gapStart_ ? index : index + (gapEnd_ - gapStart_);
+}
+
+template<typename T>
+void GapBuffer<T>::expand()
+{
+    int newCapacity = capacity_ * GROWTH_FACTOR;
+    int afterGap = capacity_ - gapEnd_;
+
+    if (newCapacity <= capacity_)
+    {
+        newCapacity = capacity_ + 1;
+    }
+
+    T* newBuffer = new T[newCapacity];
+
+    for (int i = 0; i < gapStart_; i++)
+    {
+        newBuffer[i] = buffer_[i];
+    }
+
+    // the elements after the gap stay at the end of the buffer
+    for (int i = 0; i < afterGap; i++)
+    {
+        newBuffer[newCapacity - afterGap + i] = buffer_[gapEnd_ + i];
+    }
+
+    delete[] buffer_;
+
+    buffer_ = newBuffer;
+    capacity_ = newCapacity;
+    gapEnd_ = newCapacity - afterGap;
+}
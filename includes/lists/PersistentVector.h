@@ -0,0 +1,713 @@
+#pragma once
+
+#include "DynamicArray.h"
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+/** An immutable vector that shares structure between versions.
+ * The items are kept in a 32-way trie of leaves plus a separate tail leaf, so get is
+ * O(log32 n), set/pushBack/popBack return a new version in O(log32 n) (pushBack/popBack
+ * are O(1) amortized through the tail) and copying a version (a snapshot) is O(1).
+ * Use a Transient to apply many updates without copying a path for each of them. */
+template<typename T>
+class PersistentVector
+{
+public:
+    class Transient;
+
+    /** Create an empty vector. */
+    PersistentVector();
+
+    /** Create a vector holding the items of a given array. */
+    PersistentVector(T* arr, int len);
+
+    /** Create a vector holding the items of a dynamic array. */
+    explicit PersistentVector(const DynamicArray<T>& arr);
+
+    /** Take a snapshot of another version in O(1). */
+    PersistentVector(const PersistentVector<T>& other);
+
+    PersistentVector(PersistentVector<T>&& other);
+
+    ~PersistentVector();
+
+    PersistentVector<T>& operator=(const PersistentVector<T>& other);
+
+    PersistentVector<T>& operator=(PersistentVector<T>&& other);
+
+    /** Get the number of items in the vector. */
+    int size() const;
+
+    /** Check if the vector is empty. */
+    bool isEmpty() const;
+
+    /** Get the item in the given index. */
+    T get(int index) const;
+
+    /** @return a new version where the item in the given index is replaced. */
+    PersistentVector<T> set(int index, T item) const;
+
+    /** @return a new version with an item added at the end. */
+    PersistentVector<T> pushBack(T item) const;
+
+    /** @return a new version without the last item. */
+    PersistentVector<T> popBack() const;
+
+    /** Start a batch of in-place updates on top of this version (which stays unchanged). */
+    Transient transient() const;
+
+    /** A mutable version of a vector, for batch updates.
+     * It copies each trie node at most once and then updates it in place.
+     * @note that after calling persistent() the transient cannot be used anymore. */
+    class Transient
+    {
+    public:
+        explicit Transient(const PersistentVector<T>& vector);
+
+        // two transients must never own the same nodes
+        Transient(const Transient& other) = delete;
+
+        Transient(Transient&& other);
+
+        int size() const;
+
+        T get(int index) const;
+
+        void set(int index, T item);
+
+        void pushBack(T item);
+
+        void popBack();
+
+        /** Freeze the updates into a persistent vector in O(1). */
+        PersistentVector<T> persistent();
+
+    private:
+        PersistentVector<T> vector_;
+        long owner_;
+
+        void ensureEditable() const;
+    };
+
+private:
+    static const int BITS = 5;
+    static const int WIDTH = 1 << BITS;
+    static const int MASK = WIDTH - 1;
+
+    /** A trie node, shared between versions and released when its count drops to zero.
+     * owner is the transient that may update it in place (0 - none). */
+    struct Node
+    {
+        std::atomic<int> refs;
+        long owner;
+
+        explicit Node(long o) : refs(1), owner(o)
+        {
+        }
+    };
+
+    struct Leaf : Node
+    {
+        T items[WIDTH];
+
+        explicit Leaf(long o) : Node(o)
+        {
+        }
+    };
+
+    struct Branch : Node
+    {
+        Node* children[WIDTH];
+
+        explicit Branch(long o) : Node(o)
+        {
+            for (int i = 0; i < WIDTH; i++)
+            {
+                children[i] = nullptr;
+            }
+        }
+    };
+
+    int size_;
+    int shift_;         // the level of the root, leaves are at level 0
+    Node* root_;        // nullptr while all the items fit in the tail
+    Leaf* tail_;
+
+    /** the index of the first item in the tail. */
+    int tailOffset() const;
+
+    /** find the leaf holding the item in the given index. */
+    Leaf* leafFor(int index) const;
+
+    // In-place updates, nodes not owned by owner are copied first (0 - copy every node on the path)
+
+    void assign(int index, T item, long owner);
+
+    void append(T item, long owner);
+
+    void removeLast(long owner);
+
+    Node* pushTail(int level, Node* parent, Leaf* tail, long owner);
+
+    Node* popTail(int level, Node* node, long owner);
+
+    /** build a path of branches from a given level down to a leaf. */
+    static Node* newPath(int level, Node* node, long owner);
+
+    // Node sharing
+
+    /** get a node that owner may change in place, copying it if needed.
+     * @note that the given reference is consumed and the returned one replaces it. */
+    static Node* editable(Node* node, int level, long owner);
+
+    static void retain(Node* node);
+
+    static void release(Node* node, int level);
+
+    static long nextOwner();
+};
+
+// Constructors
+
+template<typename T>
+PersistentVector<T>::PersistentVector()
+{
+    size_ = 0;
+    shift_ = BITS;
+    root_ = nullptr;
+    tail_ = new Leaf(0);
+}
+
+template<typename T>
+PersistentVector<T>::PersistentVector(T* arr, int len) : PersistentVector<T>()
+{
+    Transient batch(*this);
+
+    for (int i = 0; i < len; i++)
+    {
+        batch.pushBack(arr[i]);
+    }
+
+    *this = batch.persistent();
+}
+
+template<typename T>
+PersistentVector<T>::PersistentVector(const DynamicArray<T>& arr) : PersistentVector<T>()
+{
+    Transient batch(*this);
+
+    for (int i = 0; i < arr.size(); i++)
+    {
+        batch.pushBack(arr.get(i));
+    }
+
+    *this = batch.persistent();
+}
+
+template<typename T>
+PersistentVector<T>::PersistentVector(const PersistentVector<T>& other)
+{
+    size_ = other.size_;
+    shift_ = other.shift_;
+    root_ = other.root_;
+    tail_ = other.tail_;
+
+    retain(root_);
+    retain(tail_);
+}
+
+template<typename T>
+PersistentVector<T>::PersistentVector(PersistentVector<T>&& other)
+{
+    size_ = other.size_;
+    shift_ = other.shift_;
+    root_ = other.root_;
+    tail_ = other.tail_;
+
+    other.size_ = 0;
+    other.root_ = nullptr;
+    other.tail_ = nullptr;
+}
+
+template<typename T>
+PersistentVector<T>::~PersistentVector()
+{
+    release(root_, shift_);
+    release(tail_, 0);
+
+    root_ = nullptr;
+    tail_ = nullptr;
+    size_ = 0;
+}
+
+template<typename T>
+PersistentVector<T>& PersistentVector<T>::operator=(const PersistentVector<T>& other)
+{
+    // retain first, in case both share the nodes
+    retain(other.root_);
+    retain(other.tail_);
+
+    release(root_, shift_);
+    release(tail_, 0);
+
+    size_ = other.size_;
+    shift_ = other.shift_;
+    root_ = other.root_;
+    tail_ = other.tail_;
+
+    return *this;
+}
+
+template<typename T>
+PersistentVector<T>& PersistentVector<T>::operator=(PersistentVector<T>&& other)
+{
+    if (this != &other)
+    {
+        release(root_, shift_);
+        release(tail_, 0);
+
+        size_ = other.size_;
+        shift_ = other.shift_;
+        root_ = other.root_;
+        tail_ = other.tail_;
+
+        other.size_ = 0;
+        other.root_ = nullptr;
+        other.tail_ = nullptr;
+    }
+
+    return *this;
+}
+
+// Operations
+
+template<typename T>
+inline int PersistentVector<T>::size() const
+{
+    return size_;
+}
+
+template<typename T>
+inline bool PersistentVector<T>::isEmpty() const
+{
+    return size_ == 0;
+}
+
+template<typename T>
+T PersistentVector<T>::get(int index) const
+{
+    if (index < 0 || index >= size_)
+    {
+        throw std::out_of_range("got illegal index");
+    }
+
+    return leafFor(index)->items[index & MASK];
+}
+
+template<typename T>
+PersistentVector<T> PersistentVector<T>::set(int index, T item) const
+{
+    PersistentVector<T> result(*this);
+
+    result.assign(index, item, 0);
+
+    return result;
+}
+
+template<typename T>
+PersistentVector<T> PersistentVector<T>::pushBack(T item) const
+{
+    PersistentVector<T> result(*this);
+
+    result.append(item, 0);
+
+    return result;
+}
+
+template<typename T>
+PersistentVector<T> PersistentVector<T>::popBack() const
+{
+    PersistentVector<T> result(*this);
+
+    result.removeLast(0);
+
+    return result;
+}
+
+template<typename T>
+typename PersistentVector<T>::Transient PersistentVector<T>::transient() const
+{
+    return Transient(*this);
+}
+
+// Transient
+
+template<typename T>
+PersistentVector<T>::Transient::Transient(const PersistentVector<T>& vector) : vector_(vector)
+{
+    owner_ = nextOwner();
+}
+
+template<typename T>
+PersistentVector<T>::Transient::Transient(Transient&& other) : vector_(std::move(other.vector_))
+{
+    owner_ = other.owner_;
+    other.owner_ = 0;
+}
+
+template<typename T>
+int PersistentVector<T>::Transient::size() const
+{
+    return vector_.size();
+}
+
+template<typename T>
+T PersistentVector<T>::Transient::get(int index) const
+{
+    ensureEditable();
+
+    return vector_.get(index);
+}
+
+template<typename T>
+void PersistentVector<T>::Transient::set(int index, T item)
+{
+    ensureEditable();
+
+    vector_.assign(index, item, owner_);
+}
+
+template<typename T>
+void PersistentVector<T>::Transient::pushBack(T item)
+{
+    ensureEditable();
+
+    vector_.append(item, owner_);
+}
+
+template<typename T>
+void PersistentVector<T>::Transient::popBack()
+{
+    ensureEditable();
+
+    vector_.removeLast(owner_);
+}
+
+template<typename T>
+PersistentVector<T> PersistentVector<T>::Transient::persistent()
+{
+    ensureEditable();
+
+    // the owned nodes are shared from now on, so they must not be changed again
+    owner_ = 0;
+
+    return vector_;
+}
+
+template<typename T>
+void PersistentVector<T>::Transient::ensureEditable() const
+{
+    if (owner_ == 0)
+    {
+        throw std::logic_error("this transient was already made persistent");
+    }
+}
+
+// PRIVATES
+
+template<typename T>
+inline int PersistentVector<T>::tailOffset() const
+{
+    return size_ < WIDTH ? 0 : ((size_ - 1) >> BITS) << BITS;
+}
+
+template<typename T>
+typename PersistentVector<T>::Leaf* PersistentVector<T>::leafFor(int index) const
+{
+    if (index >= tailOffset())
+    {
+        return tail_;
+    }
+
+    Node* node = root_;
+
+    for (int level = shift_; level > 0; level -= BITS)
+    {
+        node = static_cast<Branch*>(node)->children[(index >> level) & MASK];
+    }
+
+    return static_cast<Leaf*>(node);
+}
+
+template<typename T>
+void PersistentVector<T>::assign(int index, T item, long owner)
+{
+    if (index < 0 || index >= size_)
+    {
+        throw std::out_of_range("got illegal index");
+    }
+
+    if (index >= tailOffset())
+    {
+        tail_ = static_cast<Leaf*>(editable(tail_, 0, owner));
+        tail_->items[index & MASK] = item;
+        return;
+    }
+
+    // copy the path from the root to the leaf
+    root_ = editable(root_, shift_, owner);
+
+    Node* node = root_;
+
+    for (int level = shift_; level > 0; level -= BITS)
+    {
+        Branch* branch = static_cast<Branch*>(node);
+        int child = (index >> level) & MASK;
+
+        branch->children[child] = editable(branch->children[child], level - BITS, owner);
+        node = branch->children[child];
+    }
+
+    static_cast<Leaf*>(node)->items[index & MASK] = item;
+}
+
+template<typename T>
+void PersistentVector<T>::append(T item, long owner)
+{
+    int inTail = size_ - tailOffset();
+
+    // room in the tail
+    if (inTail < WIDTH)
+    {
+        tail_ = static_cast<Leaf*>(editable(tail_, 0, owner));
+        tail_->items[inTail] = item;
+        size_++;
+        return;
+    }
+
+    // the tail is full, move it into the trie
+    if (root_ == nullptr)
+    {
+        Branch* root = new Branch(owner);
+
+        root->children[0] = tail_;
+        root_ = root;
+        shift_ = BITS;
+    }
+    // the trie is full, add a level above the root
+    else if ((size_ >> BITS) > (1 << shift_))
+    {
+        Branch* root = new Branch(owner);
+
+        root->children[0] = root_;
+        root->children[1] = newPath(shift_, tail_, owner);
+        root_ = root;
+        shift_ += BITS;
+    }
+    else
+    {
+        root_ = pushTail(shift_, root_, tail_, owner);
+    }
+
+    tail_ = new Leaf(owner);
+    tail_->items[0] = item;
+    size_++;
+}
+
+template<typename T>
+void PersistentVector<T>::removeLast(long owner)
+{
+    if (size_ == 0)
+    {
+        throw std::underflow_error("this vector is empty");
+    }
+
+    // the items beyond the size are never read, so there is nothing to copy
+    if (size_ - tailOffset() > 1 || size_ == 1)
+    {
+        size_--;
+        return;
+    }
+
+    // the tail becomes empty, the last leaf of the trie becomes the new tail
+    Leaf* newTail = leafFor(size_ - 2);
+
+    retain(newTail);
+    release(tail_, 0);
+    tail_ = newTail;
+
+    root_ = popTail(shift_, root_, owner);
+
+    if (root_ == nullptr)
+    {
+        shift_ = BITS;
+    }
+    // the root has a single child, it is not needed anymore
+    else if (shift_ > BITS && static_cast<Branch*>(root_)->children[1] == nullptr)
+    {
+        Node* child = static_cast<Branch*>(root_)->children[0];
+
+        retain(child);
+        release(root_, shift_);
+
+        root_ = child;
+        shift_ -= BITS;
+    }
+
+    size_--;
+}
+
+template<typename T>
+typename PersistentVector<T>::Node* PersistentVector<T>::pushTail(int level, Node* parent, Leaf* tail, long owner)
+{
+    // size_ is still the number of items before the new one, the tail is full
+    int child = ((size_ - 1) >> level) & MASK;
+    Branch* branch = static_cast<Branch*>(editable(parent, level, owner));
+
+    if (level == BITS)
+    {
+        branch->children[child] = tail;
+    }
+    else if (branch->children[child])
+    {
+        branch->children[child] = pushTail(level - BITS, branch->children[child], tail, owner);
+    }
+    else
+    {
+        branch->children[child] = newPath(level - BITS, tail, owner);
+    }
+
+    return branch;
+}
+
+template<typename T>
+typename PersistentVector<T>::Node* PersistentVector<T>::popTail(int level, Node* node, long owner)
+{
+    // size_ is still the number of items before the removal, the last leaf in the trie holds index size_ - 2
+    int child = ((size_ - 2) >> level) & MASK;
+
+    // the leaf to drop is the only one under this node
+    if (level == BITS && child == 0)
+    {
+        release(node, level);
+        return nullptr;
+    }
+
+    Branch* branch = static_cast<Branch*>(editable(node, level, owner));
+
+    if (level == BITS)
+    {
+        release(branch->children[child], 0);
+        branch->children[child] = nullptr;
+    }
+    else
+    {
+        branch->children[child] = popTail(level - BITS, branch->children[child], owner);
+
+        // nothing is left under this node
+        if (branch->children[child] == nullptr && child == 0)
+        {
+            release(branch, level);
+            return nullptr;
+        }
+    }
+
+    return branch;
+}
+
+template<typename T>
+typename PersistentVector<T>::Node* PersistentVector<T>::newPath(int level, Node* node, long owner)
+{
+    if (level == 0)
+    {
+        return node;
+    }
+
+    Branch* branch = new Branch(owner);
+
+    branch->children[0] = newPath(level - BITS, node, owner);
+
+    return branch;
+}
+
+template<typename T>
+typename PersistentVector<T>::Node* PersistentVector<T>::editable(Node* node, int level, long owner)
+{
+    if (owner != 0 && node->owner == owner)
+    {
+        return node;
+    }
+
+    Node* copy;
+
+    if (level == 0)
+    {
+        Leaf* leaf = new Leaf(owner);
+
+        for (int i = 0; i < WIDTH; i++)
+        {
+            leaf->items[i] = static_cast<Leaf*>(node)->items[i];
+        }
+
+        copy = leaf;
+    }
+    else
+    {
+        Branch* branch = new Branch(owner);
+
+        // the copy shares the children of the original
+        for (int i = 0; i < WIDTH; i++)
+        {
+            branch->children[i] = static_cast<Branch*>(node)->children[i];
+            retain(branch->children[i]);
+        }
+
+        copy = branch;
+    }
+
+    release(node, level);
+
+    return copy;
+}
+
+template<typename T>
+inline void PersistentVector<T>::retain(Node* node)
+{
+    if (node)
+    {
+        node->refs++;
+    }
+}
+
+template<typename T>
+void PersistentVector<T>::release(Node* node, int level)
+{
+    if (node == nullptr || --node->refs > 0)
+    {
+        return;
+    }
+
+    if (level == 0)
+    {
+        delete static_cast<Leaf*>(node);
+        return;
+    }
+
+    Branch* branch = static_cast<Branch*>(node);
+
+    for (int i = 0; i < WIDTH; i++)
+    {
+        release(branch->children[i], level - BITS);
+    }
+
+    delete branch;
+}
+
+template<typename T>
+long PersistentVector<T>::nextOwner()
+{
+    static std::atomic<long> counter(0);
+
+    return ++counter;
+}
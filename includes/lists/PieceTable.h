@@ -0,0 +1,387 @@
+#pragma once
+
+#include "List.h"
+#include "DynamicArray.h"
+#include <stdexcept>
+
+/** A list made of a large read-only base array and small edits on top of it.
+ * The list is described by pieces, each piece is a run of either the base array or an
+ * append-only buffer of added items, so an edit never copies the base.
+ * Accesses near the previous access are O(1), others cost O(number of pieces).
+ * @note that the base array is not copied, it must outlive the table and stay unchanged. */
+template<typename T>
+class PieceTable : public List<T>
+{
+public:
+    /** Create an empty table. */
+    PieceTable();
+
+    /** Create a table over a base array, without copying it. */
+    PieceTable(const T* base, int len);
+
+    /** get the number of pieces the list is made of. */
+    int pieces() const;
+
+    /** add an item to the end of the list. */
+    void add(T item);
+
+    /** add an item to the list in a specific index. */
+    void add(T item, int index);
+
+    /** set the item in a given index to a new value. returns the old value. */
+    T set(int index, T item);
+
+    /** get the item in the given index. */
+    T get(int index) const;
+
+    /** remove an item from the list. */
+    bool remove(T item);
+
+    T removeAt(int index);
+
+    T removeFirst();
+
+    T removeLast();
+
+    /** check if an item is in the list. */
+    bool contains(T item) const;
+
+    /** copy the items of the list, in order, into a new array. */
+    DynamicArray<T>* toArray() const;
+
+private:
+    /** A run of length items, starting at start in the base or in the added items. */
+    struct Piece
+    {
+        bool added;
+        int start;
+        int length;
+
+        Piece()
+        {
+            added = false;
+            start = 0;
+            length = 0;
+        }
+
+        Piece(bool a, int s, int l)
+        {
+            added = a;
+            start = s;
+            length = l;
+        }
+
+        bool operator==(const Piece& other) const
+        {
+            return added == other.added && start == other.start && length == other.length;
+        }
+
+        bool operator!=(const Piece& other) const
+        {
+            return !operator==(other);
+        }
+    };
+
+    const T* base_;
+    DynamicArray<T> added_;
+    DynamicArray<Piece> pieces_;
+
+    // the last piece that was found and the index of its first item, used as a finger
+    mutable int lastPiece_;
+    mutable int lastPieceStart_;
+
+    /** find the piece containing the item in the given index.
+     * @param offset gets the position of the item inside the piece. */
+    int findPiece(int index, int& offset) const;
+
+    /** get the item at a given offset of a piece. */
+    T itemAt(const Piece& piece, int offset) const;
+
+    /** remember a piece and the index of its first item for the next search. */
+    void setFinger(int piece, int start) const;
+};
+
+template<typename T>
+PieceTable<T>::PieceTable()
+{
+    this->size_ = 0;
+    base_ = nullptr;
+    lastPiece_ = 0;
+    lastPieceStart_ = 0;
+}
+
+template<typename T>
+PieceTable<T>::PieceTable(const T* base, int len)
+{
+    if (len < 0)
+    {
+        throw std::invalid_argument("length cannot be negative");
+    }
+
+    this->size_ = len;
+    base_ = base;
+    lastPiece_ = 0;
+    lastPieceStart_ = 0;
+
+    if (len > 0)
+    {
+        pieces_.add(Piece(false, 0, len));
+    }
+}
+
+template<typename T>
+inline int PieceTable<T>::pieces() const
+{
+    return pieces_.size();
+}
+
+template<typename T>
+void PieceTable<T>::add(T item)
+{
+    add(item, this->size_);
+}
+
+template<typename T>
+void PieceTable<T>::add(T item, int index)
+{
+    if (index < 0 || index > this->size_)
+    {
+        throw std::out_of_range("cannot insert out of the list");
+    }
+
+    int offset = 0, piece = pieces_.size(), start = this->size_;
+
+    added_.add(item);
+
+    if (index < this->size_)
+    {
+        piece = findPiece(index, offset);
+        start = index - offset;
+    }
+
+    // inside a piece - split it around the new item
+    if (offset > 0)
+    {
+        Piece& current = pieces_[piece];
+        Piece tail(current.added, current.start + offset, current.length - offset);
+
+        current.length = offset;
+
+        pieces_.add(Piece(true, added_.size() - 1, 1), piece + 1);
+        pieces_.add(tail, piece + 2);
+
+        setFinger(piece + 1, index);
+    }
+    // right after a piece that ends with the last added item (typing) - extend it
+    else if (piece > 0 && pieces_[piece - 1].added &&
+        pieces_[piece - 1].start + pieces_[piece - 1].length == added_.size() - 1)
+    {
+        Piece& previous = pieces_[piece - 1];
+
+        previous.length++;
+
+        setFinger(piece - 1, start - previous.length + 1);
+    }
+    // between two pieces
+    else
+    {
+        pieces_.add(Piece(true, added_.size() - 1, 1), piece);
+
+        setFinger(piece, index);
+    }
+
+    this->size_++;
+}
+
+template<typename T>
+T PieceTable<T>::set(int index, T item)
+{
+    T old = removeAt(index);
+
+    add(item, index);
+
+    return old;
+}
+
+template<typename T>
+T PieceTable<T>::get(int index) const
+{
+    if (index < 0 || index >= this->size_)
+    {
+        throw std::out_of_range("got illegal index");
+    }
+
+    int offset;
+    int piece = findPiece(index, offset);
+
+    return itemAt(pieces_.get(piece), offset);
+}
+
+template<typename T>
+bool PieceTable<T>::remove(T item)
+{
+    int i = 0;
+
+    while (i < this->size_ && get(i) != item)
+    {
+        i++;
+    }
+
+    // the item is not in the list
+    if (i == this->size_)
+    {
+        return false;
+    }
+
+    removeAt(i);
+
+    return true;
+}
+
+template<typename T>
+T PieceTable<T>::removeAt(int index)
+{
+    if (index < 0 || index >= this->size_)
+    {
+        throw std::out_of_range("got illegal index");
+    }
+
+    int offset;
+    int piece = findPiece(index, offset);
+    Piece& current = pieces_[piece];
+    T val = itemAt(current, offset);
+
+    if (current.length == 1)
+    {
+        pieces_.removeAt(piece);
+    }
+    else if (offset == 0)
+    {
+        current.start++;
+        current.length--;
+    }
+    else if (offset == current.length - 1)
+    {
+        current.length--;
+    }
+    // in the middle of a piece - split it and leave the item out
+    else
+    {
+        Piece tail(current.added, current.start + offset + 1, current.length - offset - 1);
+
+        current.length = offset;
+
+        pieces_.add(tail, piece + 1);
+    }
+
+    // the piece still starts at the same index (or was replaced by the one after it)
+    setFinger(piece, index - offset);
+
+    this->size_--;
+
+    return val;
+}
+
+template<typename T>
+T PieceTable<T>::removeFirst()
+{
+    if (this->isEmpty())
+    {
+        throw std::underflow_error("this list is empty");
+    }
+
+    return removeAt(0);
+}
+
+template<typename T>
+T PieceTable<T>::removeLast()
+{
+    if (this->isEmpty())
+    {
+        throw std::underflow_error("this list is empty");
+    }
+
+    return removeAt(this->size_ - 1);
+}
+
+template<typename T>
+bool PieceTable<T>::contains(T item) const
+{
+    for (int p = 0; p < pieces_.size(); p++)
+    {
+        Piece piece = pieces_.get(p);
+
+        for (int i = 0; i < piece.length; i++)
+        {
+            if (itemAt(piece, i) == item)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+template<typename T>
+DynamicArray<T>* PieceTable<T>::toArray() const
+{
+    DynamicArray<T>* arr = new DynamicArray<T>(this->size_ > 0 ? this->size_ : 1);
+
+    for (int p = 0; p < pieces_.size(); p++)
+    {
+        Piece piece = pieces_.get(p);
+
+        for (int i = 0; i < piece.length; i++)
+        {
+            arr->add(itemAt(piece, i));
+        }
+    }
+
+    return arr;
+}
+
+template<typename T>
+int PieceTable<T>::findPiece(int index, int& offset) const
+{
+    int piece = lastPiece_, start = lastPieceStart_;
+
+    // the finger is stale (the pieces after it were removed)
+    if (piece >= pieces_.size())
+    {
+        piece = 0;
+        start = 0;
+    }
+
+    // walk from the finger to the piece containing the index
+    while (index < start)
+    {
+        piece--;
+        start -= pieces_.get(piece).length;
+    }
+
+    while (index >= start + pieces_.get(piece).length)
+    {
+        start += pieces_.get(piece).length;
+        piece++;
+    }
+
+    setFinger(piece, start);
+
+    offset = index - start;
+
+    return piece;
+}
+
+template<typename T>
+inline T PieceTable<T>::itemAt(const Piece& piece, int offset) const
+{
+    return piece.added ? added_.get(piece.start + offset) : base_[piece.start + offset];
+}
+
+template<typename T>
+inline void PieceTable<T>::setFinger(int piece, int start) const
+{
+    lastPiece_ = piece;
+    lastPieceStart_ = start;
+}
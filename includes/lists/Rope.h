@@ -0,0 +1,616 @@
+#pragma once
+
+#include "List.h"
+#include <stdexcept>
+
+/** A list kept in an AVL tree ordered by position (implicit keys).
+ * Every node knows the size of its subtree, so the position of a node is found by
+ * the sizes along the path, the same way AVLTree keeps sizes for its keys.
+ * get/set/add/removeAt are O(log n), and so are concat and split. */
+template<typename T>
+class Rope : public List<T>
+{
+public:
+    /** Create an empty list. */
+    Rope();
+
+    /** Create a list holding the items of a given array, in O(n). */
+    Rope(T* arr, int len);
+
+    ~Rope();
+
+    Rope(const Rope<T>& other) = delete;
+
+    Rope<T>& operator=(const Rope<T>& other) = delete;
+
+    /** Add an item to the end of the list. */
+    void add(T item);
+
+    void add(T item, int index);
+
+    T set(int index, T item);
+
+    T get(int index) const;
+
+    bool remove(T item);
+
+    T removeAt(int index);
+
+    T removeFirst();
+
+    T removeLast();
+
+    bool contains(T item) const;
+
+    /** Move all the items of another list to the end of this one.
+     * @note that the other list becomes empty. */
+    void concat(Rope<T>& other);
+
+    /** Split the list at a given index.
+     * this list keeps the items before the index.
+     * @return a new list with the items from the index to the end. */
+    Rope<T>* split(int index);
+
+    /** Get the height of the tree (-1 for an empty list). */
+    int getHeight() const;
+
+private:
+    struct Node
+    {
+        T item;
+        Node* left;
+        Node* right;
+        int height;
+        int size;
+
+        explicit Node(T i)
+        {
+            item = i;
+            left = nullptr;
+            right = nullptr;
+            height = 0;
+            size = 1;
+        }
+    };
+
+    Node* root_;
+
+    // Updating data
+
+    static int heightOf(Node* node);
+
+    static int sizeOf(Node* node);
+
+    /** Fix / recalculate the size and the height of a node (assuming its children are right). */
+    static void fix(Node* node);
+
+    // Balancing
+
+    static Node* leftRotation(Node* x);
+
+    static Node* rightRotation(Node* x);
+
+    /** Balance a node whose children differ in height by at most 2.
+     * @return the new root of the subtree. */
+    static Node* balance(Node* x);
+
+    // Tree Operations
+
+    static Node* build(T* arr, int from, int to);
+
+    static Node* insert(Node* node, Node* newNode, int index);
+
+    /** Remove the node in a given index from the subtree.
+     * @param removed gets the removed node (it is not deleted). */
+    static Node* detach(Node* node, int index, Node*& removed);
+
+    /** Join two trees with a middle node, all of left's items come before mid and right's after it. */
+    static Node* join(Node* left, Node* mid, Node* right);
+
+    /** Split a subtree so the first index items go to left and the others to right. */
+    static void split(Node* node, int index, Node*& left, Node*& right);
+
+    static Node* nodeAt(Node* node, int index);
+
+    /** Find the first occurrence of an item in the subtree (in-order).
+     * @return its index in the subtree, or -1 if the item is not there. */
+    static int indexOf(Node* node, T item);
+
+    static void destroy(Node* node);
+};
+
+// Constructors
+
+template<typename T>
+Rope<T>::Rope()
+{
+    root_ = nullptr;
+}
+
+template<typename T>
+Rope<T>::Rope(T* arr, int len)
+{
+    root_ = build(arr, 0, len);
+    this->size_ = len;
+}
+
+template<typename T>
+Rope<T>::~Rope()
+{
+    destroy(root_);
+    root_ = nullptr;
+    this->size_ = 0;
+}
+
+// List Operations
+
+template<typename T>
+void Rope<T>::add(T item)
+{
+    add(item, this->size_);
+}
+
+template<typename T>
+void Rope<T>::add(T item, int index)
+{
+    // here the index can be exactly the size
+    if (index < 0 || index > this->size_)
+    {
+        throw std::out_of_range("got illegal index");
+    }
+
+    root_ = insert(root_, new Node(item), index);
+    this->size_++;
+}
+
+template<typename T>
+T Rope<T>::set(int index, T item)
+{
+    if (index < 0 || index >= this->size_)
+    {
+        throw std::out_of_range("got illegal index");
+    }
+
+    Node* node = nodeAt(root_, index);
+    T old = node->item;
+
+    node->item = item;
+
+    return old;
+}
+
+template<typename T>
+T Rope<T>::get(int index) const
+{
+    if (index < 0 || index >= this->size_)
+    {
+        throw std::out_of_range("got illegal index");
+    }
+
+    return nodeAt(root_, index)->item;
+}
+
+template<typename T>
+bool Rope<T>::remove(T item)
+{
+    int index = indexOf(root_, item);
+
+    if (index == -1)
+    {
+        return false;
+    }
+
+    removeAt(index);
+
+    return true;
+}
+
+template<typename T>
+T Rope<T>::removeAt(int index)
+{
+    if (index < 0 || index >= this->size_)
+    {
+        throw std::out_of_range("got illegal index");
+    }
+
+    Node* removed = nullptr;
+
+    root_ = detach(root_, index, removed);
+    this->size_--;
+
+    T val = removed->item;
+
+    delete removed;
+
+    return val;
+}
+
+template<typename T>
+T Rope<T>::removeFirst()
+{
+    if (this->isEmpty())
+    {
+        throw std::underflow_error("this list is empty");
+    }
+
+    return removeAt(0);
+}
+
+template<typename T>
+T Rope<T>::removeLast()
+{
+    if (this->isEmpty())
+    {
+        throw std::underflow_error("this list is empty");
+    }
+
+    return removeAt(this->size_ - 1);
+}
+
+template<typename T>
+bool Rope<T>::contains(T item) const
+{
+    return indexOf(root_, item) != -1;
+}
+
+template<typename T>
+void Rope<T>::concat(Rope<T>& other)
+{
+    if (&other == this)
+    {
+        throw std::invalid_argument("cannot concatenate a list to itself");
+    }
+
+    if (other.isEmpty())
+    {
+        return;
+    }
+
+    // take the first item of the other list as the middle node of the join
+    Node* mid = nullptr;
+    Node* right = detach(other.root_, 0, mid);
+
+    root_ = join(root_, mid, right);
+    this->size_ += other.size_;
+
+    other.root_ = nullptr;
+    other.size_ = 0;
+}
+
+template<typename T>
+Rope<T>* Rope<T>::split(int index)
+{
+    if (index < 0 || index > this->size_)
+    {
+        throw std::out_of_range("got illegal index");
+    }
+
+    Rope<T>* rest = new Rope<T>();
+    Node* left = nullptr, * right = nullptr;
+
+    split(root_, index, left, right);
+
+    root_ = left;
+    rest->root_ = right;
+    rest->size_ = this->size_ - index;
+    this->size_ = index;
+
+    return rest;
+}
+
+template<typename T>
+int Rope<T>::getHeight() const
+{
+    return heightOf(root_);
+}
+
+// PRIVATES
+
+// Updating data
+
+template<typename T>
+inline int Rope<T>::heightOf(Node* node)
+{
+    return node ? node->height : -1;
+}
+
+template<typename T>
+inline int Rope<T>::sizeOf(Node* node)
+{
+    return node ? node->size : 0;
+}
+
+template<typename T>
+inline void Rope<T>::fix(Node* node)
+{
+    int leftHeight = heightOf(node->left), rightHeight = heightOf(node->right);
+
+    node->height = leftHeight > rightHeight ? leftHeight + 1 : rightHeight + 1;
+    node->size = sizeOf(node->left) + sizeOf(node->right) + 1;
+}
+
+// Balancing
+
+template<typename T>
+typename Rope<T>::Node* Rope<T>::leftRotation(Node* x)
+{
+    /*
+     *   x
+     *  / \
+     * c   y    =>      y
+     *    / \          / \
+     *   a   b        x   b
+     *               / \
+     *              c   a
+     */
+
+    Node* y = x->right;
+
+    x->right = y->left;
+    y->left = x;
+
+    fix(x);
+    fix(y);
+
+    return y;
+}
+
+template<typename T>
+typename Rope<T>::Node* Rope<T>::rightRotation(Node* x)
+{
+    /*
+     *     x
+     *    / \
+     *   y   c  =>    y
+     *  / \          / \
+     * a   b        a   x
+     *                 / \
+     *                b   c
+     */
+
+    Node* y = x->left;
+
+    x->left = y->right;
+    y->right = x;
+
+    fix(x);
+    fix(y);
+
+    return y;
+}
+
+template<typename T>
+typename Rope<T>::Node* Rope<T>::balance(Node* x)
+{
+    fix(x);
+
+    int diff = heightOf(x->left) - heightOf(x->right);
+
+    // Left
+    if (diff > 1)
+    {
+        // Left-Right
+        if (heightOf(x->left->left) < heightOf(x->left->right))
+        {
+            x->left = leftRotation(x->left);
+        }
+
+        return rightRotation(x);
+    }
+
+    // Right
+    if (diff < -1)
+    {
+        // Right-Left
+        if (heightOf(x->right->right) < heightOf(x->right->left))
+        {
+            x->right = rightRotation(x->right);
+        }
+
+        return leftRotation(x);
+    }
+
+    return x;
+}
+
+// Tree Operations
+
+template<typename T>
+typename Rope<T>::Node* Rope<T>::build(T* arr, int from, int to)
+{
+    if (from >= to)
+    {
+        return nullptr;
+    }
+
+    int middle = from + (to - from) / 2;
+    Node* node = new Node(arr[middle]);
+
+    node->left = build(arr, from, middle);
+    node->right = build(arr, middle + 1, to);
+
+    fix(node);
+
+    return node;
+}
+
+template<typename T>
+typename Rope<T>::Node* Rope<T>::insert(Node* node, Node* newNode, int index)
+{
+    if (!node)
+    {
+        return newNode;
+    }
+
+    int leftSize = sizeOf(node->left);
+
+    if (index <= leftSize)
+    {
+        node->left = insert(node->left, newNode, index);
+    }
+    else
+    {
+        node->right = insert(node->right, newNode, index - leftSize - 1);
+    }
+
+    return balance(node);
+}
+
+template<typename T>
+typename Rope<T>::Node* Rope<T>::detach(Node* node, int index, Node*& removed)
+{
+    int leftSize = sizeOf(node->left);
+
+    if (index < leftSize)
+    {
+        node->left = detach(node->left, index, removed);
+        return balance(node);
+    }
+
+    if (index > leftSize)
+    {
+        node->right = detach(node->right, index - leftSize - 1, removed);
+        return balance(node);
+    }
+
+    // this is the node to remove
+    removed = node;
+
+    if (!node->left || !node->right)
+    {
+        return node->left ? node->left : node->right;
+    }
+
+    // replace the node with its successor (the first node of the right subtree)
+    Node* successorNode = nullptr;
+    Node* right = detach(node->right, 0, successorNode);
+
+    successorNode->left = node->left;
+    successorNode->right = right;
+
+    node->left = nullptr;
+    node->right = nullptr;
+
+    return balance(successorNode);
+}
+
+template<typename T>
+typename Rope<T>::Node* Rope<T>::join(Node* left, Node* mid, Node* right)
+{
+    int leftHeight = heightOf(left), rightHeight = heightOf(right);
+
+    // left is taller - go down its right spine until the heights are close
+    if (leftHeight > rightHeight + 1)
+    {
+        left->right = join(left->right, mid, right);
+        return balance(left);
+    }
+
+    // right is taller - go down its left spine
+    if (rightHeight > leftHeight + 1)
+    {
+        right->left = join(left, mid, right->left);
+        return balance(right);
+    }
+
+    mid->left = left;
+    mid->right = right;
+
+    fix(mid);
+
+    return mid;
+}
+
+template<typename T>
+void Rope<T>::split(Node* node, int index, Node*& left, Node*& right)
+{
+    if (!node)
+    {
+        left = nullptr;
+        right = nullptr;
+        return;
+    }
+
+    int leftSize = sizeOf(node->left);
+    Node* subLeft = node->left, * subRight = node->right;
+    Node* first = nullptr, * second = nullptr;
+
+    if (index <= leftSize)
+    {
+        // the node and its right subtree go to the right
+        split(subLeft, index, first, second);
+
+        left = first;
+        right = join(second, node, subRight);
+    }
+    else
+    {
+        // the node and its left subtree go to the left
+        split(subRight, index - leftSize - 1, first, second);
+
+        left = join(subLeft, node, first);
+        right = second;
+    }
+}
+
+template<typename T>
+typename Rope<T>::Node* Rope<T>::nodeAt(Node* node, int index)
+{
+    int leftSize = sizeOf(node->left);
+
+    while (index != leftSize)
+    {
+        if (index < leftSize)
+        {
+            node = node->left;
+        }
+        else
+        {
+            index -= leftSize + 1;
+            node = node->right;
+        }
+
+        leftSize = sizeOf(node->left);
+    }
+
+    return node;
+}
+
+template<typename T>
+int Rope<T>::indexOf(Node* node, T item)
+{
+    if (!node)
+    {
+        return -1;
+    }
+
+    int index = indexOf(node->left, item);
+
+    if (index != -1)
+    {
+        return index;
+    }
+
+    if (node->item == item)
+    {
+        return sizeOf(node->left);
+    }
+
+    index = indexOf(node->right, item);
+
+    return index == -1 ? -1 : sizeOf(node->left) + 1 + index;
+}
+
+template<typename T>
+void Rope<T>::destroy(Node* node)
+{
+    if (!node)
+    {
+        return;
+    }
+
+    destroy(node->left);
+    destroy(node->right);
+
+    delete node;
+}
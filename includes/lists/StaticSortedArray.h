@@ -0,0 +1,321 @@
+#pragma once
+
+#include "DynamicArray.h"
+#include "../Sort.h"
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+/** A read-only sorted array laid out for fast searching.
+ * The items are stored in Eytzinger (BFS) order: the children of position k are 2k and 2k + 1,
+ * so the first levels of every search share a few cache lines and the next levels can be
+ * prefetched ahead. The items start on a cache line, so the descendants of a position
+ * log2(LINE) levels down (see LINE) share one line when the size of an item is a power of 2.
+ * The searches are branchless, they only compare and shift.
+ * Ranks are the positions of the items in sorted order (0 to size). */
+template<typename T>
+class StaticSortedArray
+{
+public:
+    /** Build from an array of items (not necessarily sorted). */
+    StaticSortedArray(const T* arr, int len);
+
+    /** Build from a dynamic array of items (not necessarily sorted). */
+    explicit StaticSortedArray(const DynamicArray<T>& arr);
+
+    ~StaticSortedArray();
+
+    StaticSortedArray(const StaticSortedArray<T>& other) = delete;
+
+    StaticSortedArray<T>& operator=(const StaticSortedArray<T>& other) = delete;
+
+    /** Get the number of items. */
+    int size() const;
+
+    bool isEmpty() const;
+
+    /** Get the rank of the first item that is not less than key (size() if there is none). */
+    int lowerBound(T key) const;
+
+    /** Get the rank of the first item that is greater than key (size() if there is none). */
+    int upperBound(T key) const;
+
+    /** Get the number of items less than or equal to key. */
+    int rank(T key) const;
+
+    /** Check if the key is in the array. */
+    bool contains(T key) const;
+
+    /** Find the lower bounds of many keys at once.
+     * The searches advance together level by level, so their cache misses overlap.
+     * @param results gets the rank for each key. */
+    void lowerBounds(const T* keys, int* results, int count) const;
+
+private:
+    void* block_;       // the raw block items_ is built in
+    T* items_;          // in Eytzinger order, position 0 is not used, aligned to a cache line
+    int* ranks_;        // the rank of the item in each position
+    int size_;
+
+    static const int CACHE_LINE = 64;
+
+    // the number of positions that fit in a cache line, used to prefetch log2(LINE) levels ahead
+    // (the LINE descendants of position k that many levels down are positions k * LINE onwards)
+    static const int LINE = sizeof(T) < CACHE_LINE ? CACHE_LINE / sizeof(T) : 1;
+
+    // the number of searches advancing together in lowerBounds
+    static const int BATCH = 16;
+
+    void build(const T* sorted, int len);
+
+    /** Lay out the sorted items in order on the subtree rooted at position k.
+     * @return the index of the next item to place. */
+    int fill(const T* sorted, int next, int k);
+
+    /** Get the position (0 - none) of the first item not less than key (strict = false)
+     * or greater than key (strict = true). */
+    int search(T key, bool strict) const;
+
+    /** Undo the last right turns and the left turn before them to get the answer's position. */
+    static int answer(int k);
+
+    void prefetch(long long k) const;
+};
+
+// Constructors
+
+template<typename T>
+StaticSortedArray<T>::StaticSortedArray(const T* arr, int len)
+{
+    if (len < 0)
+    {
+        throw std::invalid_argument("length cannot be negative");
+    }
+
+    T* sorted = new T[len > 0 ? len : 1];
+
+    for (int i = 0; i < len; i++)
+    {
+        sorted[i] = arr[i];
+    }
+
+    Sort<T>::quickSort(sorted, len);
+    build(sorted, len);
+
+    delete[] sorted;
+}
+
+template<typename T>
+StaticSortedArray<T>::StaticSortedArray(const DynamicArray<T>& arr)
+{
+    int len = arr.size();
+    T* sorted = new T[len > 0 ? len : 1];
+
+    for (int i = 0; i < len; i++)
+    {
+        sorted[i] = arr.get(i);
+    }
+
+    Sort<T>::quickSort(sorted, len);
+    build(sorted, len);
+
+    delete[] sorted;
+}
+
+template<typename T>
+StaticSortedArray<T>::~StaticSortedArray()
+{
+    for (int k = 0; k <= size_; k++)
+    {
+        items_[k].~T();
+    }
+
+    ::operator delete(block_);
+    delete[] ranks_;
+
+    block_ = nullptr;
+    items_ = nullptr;
+    ranks_ = nullptr;
+    size_ = 0;
+}
+
+// Operations
+
+template<typename T>
+inline int StaticSortedArray<T>::size() const
+{
+    return size_;
+}
+
+template<typename T>
+inline bool StaticSortedArray<T>::isEmpty() const
+{
+    return size_ == 0;
+}
+
+template<typename T>
+int StaticSortedArray<T>::lowerBound(T key) const
+{
+    int k = search(key, false);
+
+    return k ? ranks_[k] : size_;
+}
+
+template<typename T>
+int StaticSortedArray<T>::upperBound(T key) const
+{
+    int k = search(key, true);
+
+    return k ? ranks_[k] : size_;
+}
+
+template<typename T>
+int StaticSortedArray<T>::rank(T key) const
+{
+    return upperBound(key);
+}
+
+template<typename T>
+bool StaticSortedArray<T>::contains(T key) const
+{
+    int k = search(key, false);
+
+    return k && !(key < items_[k]);
+}
+
+template<typename T>
+void StaticSortedArray<T>::lowerBounds(const T* keys, int* results, int count) const
+{
+    int positions[BATCH];
+
+    for (int first = 0; first < count; first += BATCH)
+    {
+        int lanes = count - first < BATCH ? count - first : BATCH;
+        bool active = true;
+
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            positions[lane] = 1;
+        }
+
+        // walk one level down in every search, until all of them fall off the tree
+        while (active)
+        {
+            active = false;
+
+            for (int lane = 0; lane < lanes; lane++)
+            {
+                int k = positions[lane];
+
+                if (k <= size_)
+                {
+                    prefetch((long long)k * LINE);
+                    positions[lane] = 2 * k + (items_[k] < keys[first + lane]);
+                    active = true;
+                }
+            }
+        }
+
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            int k = answer(positions[lane]);
+
+            results[first + lane] = k ? ranks_[k] : size_;
+        }
+    }
+}
+
+// PRIVATES
+
+template<typename T>
+void StaticSortedArray<T>::build(const T* sorted, int len)
+{
+    size_ = len;
+
+    // a line of slack to align the first item
+    block_ = ::operator new((len + 1) * sizeof(T) + CACHE_LINE);
+
+    uintptr_t address = reinterpret_cast<uintptr_t>(block_);
+
+    address = (address + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    items_ = reinterpret_cast<T*>(address);
+
+    for (int k = 0; k <= len; k++)
+    {
+        new (items_ + k) T();
+    }
+
+    ranks_ = new int[len + 1];
+
+    fill(sorted, 0, 1);
+}
+
+template<typename T>
+int StaticSortedArray<T>::fill(const T* sorted, int next, int k)
+{
+    if (k > size_)
+    {
+        return next;
+    }
+
+    // left subtree, then this position, then the right subtree (in-order)
+    next = fill(sorted, next, 2 * k);
+
+    items_[k] = sorted[next];
+    ranks_[k] = next;
+    next++;
+
+    return fill(sorted, next, 2 * k + 1);
+}
+
+template<typename T>
+int StaticSortedArray<T>::search(T key, bool strict) const
+{
+    int k = 1;
+
+    // go right (2k + 1) while the item is too small, left (2k) otherwise
+    if (strict)
+    {
+        while (k <= size_)
+        {
+            prefetch((long long)k * LINE);
+            k = 2 * k + !(key < items_[k]);
+        }
+    }
+    else
+    {
+        while (k <= size_)
+        {
+            prefetch((long long)k * LINE);
+            k = 2 * k + (items_[k] < key);
+        }
+    }
+
+    return answer(k);
+}
+
+template<typename T>
+inline int StaticSortedArray<T>::answer(int k)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return k >> (__builtin_ctz(~k) + 1);
+#else
+    while (k & 1)
+    {
+        k >>= 1;
+    }
+
+    return k >> 1;
+#endif
+}
+
+template<typename T>
+inline void StaticSortedArray<T>::prefetch(long long k) const
+{
+#if defined(__GNUC__) || defined(__clang__)
+    // prefetching out of the array is harmless, the hint is dropped
+    __builtin_prefetch((const char*)items_ + k * sizeof(T));
+#else
+    (void)k;
+#endif
+}
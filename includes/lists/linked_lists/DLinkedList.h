@@ -9,6 +9,40 @@ template<typename T>
 class DLinkedList : public List<T>
 {
 public:
+    /** A bidirectional cursor over the nodes of the list.
+     * The end position is the sentinel, so decrementing end() reaches the last node.
+     * @note that a cursor stays valid until the node it points to is removed. */
+    class Iterator
+    {
+    public:
+        /** Create a cursor that points nowhere. */
+        Iterator();
+
+        /** Create a cursor that points to a given node. */
+        explicit Iterator(DNode<T>* node);
+
+        /** Get the data in the node under the cursor. */
+        T operator*() const;
+
+        /** Get the node under the cursor. */
+        DNode<T>* node() const;
+
+        Iterator& operator++();
+
+        Iterator operator++(int);
+
+        Iterator& operator--();
+
+        Iterator operator--(int);
+
+        bool operator==(const Iterator& other) const;
+
+        bool operator!=(const Iterator& other) const;
+
+    private:
+        DNode<T>* node_;
+    };
+
     /** Create an empty list. */
     DLinkedList();
 
@@ -46,6 +80,37 @@ public:
 
     DNode<T>* getNode(int index) const;
 
+    // Cursors
+
+    /** Get a cursor to the first element (or end() if the list is empty). */
+    Iterator begin() const;
+
+    /** Get a cursor past the last element. */
+    Iterator end() const;
+
+    /** Insert an element right before the cursor in O(1).
+     * @return a cursor to the new element. */
+    Iterator insertBefore(Iterator pos, T item);
+
+    /** Remove the element under the cursor in O(1).
+     * @return a cursor to the element that followed the removed one. */
+    Iterator erase(Iterator pos);
+
+    /** Move all the elements of another list right before pos in O(1). */
+    void splice(Iterator pos, DLinkedList<T>& other);
+
+    /** Move a single element of another list (or of this one) right before pos in O(1). */
+    void splice(Iterator pos, DLinkedList<T>& other, Iterator it);
+
+    /** Move the range [first, last) of another list right before pos.
+     * @note that pos must not be inside the range, and that counting the range is O(count),
+     * use the overload that gets the count for an O(1) splice. */
+    void splice(Iterator pos, DLinkedList<T>& other, Iterator first, Iterator last);
+
+    /** Move the range [first, last), which holds exactly count elements, right before pos in O(1).
+     * @note that pos must not be inside the range. */
+    void splice(Iterator pos, DLinkedList<T>& other, Iterator first, Iterator last, int count);
+
 private:
     DNode<T>* head_;    // this is a sentinel node
 };
@@ -140,10 +205,11 @@ template<typename T>
 T DLinkedList<T>::removeAt(int index)
 {
     DNode<T>* node = getNode(index);
+    T retVal = node->data();
 
     remove(node);
 
-    return node->data();
+    return retVal;
 }
 
 template<typename T>
@@ -154,9 +220,9 @@ T DLinkedList<T>::removeFirst()
         throw std::underflow_error("this list is empty");
     }
 
-    T retVal = head_->data();
+    T retVal = head_->next->data();
 
-    remove(head_);
+    remove(head_->next);
 
     return retVal;
 }
@@ -335,6 +401,177 @@ DLinkedList<T>::DLinkedList()
 {
     head_ = new DNode<T>();
 
-    // here, the initializing of the heads pointers (to itself) is redundant,
-    // when adding the first item, the insertion function does that.
+    // the insertion functions do not need this, but the cursors rely on an empty list being a loop
+    head_->next = head_;
+    head_->prev = head_;
+}
+
+// Cursors
+
+template<typename T>
+DLinkedList<T>::Iterator::Iterator()
+{
+    node_ = nullptr;
+}
+
+template<typename T>
+DLinkedList<T>::Iterator::Iterator(DNode<T>* node)
+{
+    node_ = node;
+}
+
+template<typename T>
+inline T DLinkedList<T>::Iterator::operator*() const
+{
+    return node_->data();
+}
+
+template<typename T>
+inline DNode<T>* DLinkedList<T>::Iterator::node() const
+{
+    return node_;
+}
+
+template<typename T>
+inline typename DLinkedList<T>::Iterator& DLinkedList<T>::Iterator::operator++()
+{
+    node_ = node_->next;
+    return *this;
+}
+
+template<typename T>
+inline typename DLinkedList<T>::Iterator DLinkedList<T>::Iterator::operator++(int)
+{
+    Iterator old = *this;
+    node_ = node_->next;
+    return old;
+}
+
+template<typename T>
+inline typename DLinkedList<T>::Iterator& DLinkedList<T>::Iterator::operator--()
+{
+    node_ = node_->prev;
+    return *this;
+}
+
+template<typename T>
+inline typename DLinkedList<T>::Iterator DLinkedList<T>::Iterator::operator--(int)
+{
+    Iterator old = *this;
+    node_ = node_->prev;
+    return old;
+}
+
+template<typename T>
+inline bool DLinkedList<T>::Iterator::operator==(const Iterator& other) const
+{
+    return node_ == other.node_;
+}
+
+template<typename T>
+inline bool DLinkedList<T>::Iterator::operator!=(const Iterator& other) const
+{
+    return node_ != other.node_;
+}
+
+template<typename T>
+inline typename DLinkedList<T>::Iterator DLinkedList<T>::begin() const
+{
+    return Iterator(head_->next);
+}
+
+template<typename T>
+inline typename DLinkedList<T>::Iterator DLinkedList<T>::end() const
+{
+    return Iterator(head_);
+}
+
+template<typename T>
+typename DLinkedList<T>::Iterator DLinkedList<T>::insertBefore(Iterator pos, T item)
+{
+    DNode<T>* next = pos.node();
+    DNode<T>* newNode = new DNode<T>(item);
+
+    newNode->prev = next->prev;
+    newNode->next = next;
+
+    next->prev->next = newNode;
+    next->prev = newNode;
+
+    this->size_++;
+
+    return Iterator(newNode);
+}
+
+template<typename T>
+typename DLinkedList<T>::Iterator DLinkedList<T>::erase(Iterator pos)
+{
+    if (pos == end())
+    {
+        throw std::out_of_range("cannot erase the end of the list");
+    }
+
+    Iterator next(pos.node()->next);
+
+    remove(pos.node());
+
+    return next;
+}
+
+template<typename T>
+void DLinkedList<T>::splice(Iterator pos, DLinkedList<T>& other)
+{
+    splice(pos, other, other.begin(), other.end(), other.size());
+}
+
+template<typename T>
+void DLinkedList<T>::splice(Iterator pos, DLinkedList<T>& other, Iterator it)
+{
+    Iterator last = it;
+
+    splice(pos, other, it, ++last, 1);
+}
+
+template<typename T>
+void DLinkedList<T>::splice(Iterator pos, DLinkedList<T>& other, Iterator first, Iterator last)
+{
+    int count = 0;
+
+    for (Iterator it = first; it != last; ++it)
+    {
+        count++;
+    }
+
+    splice(pos, other, first, last, count);
+}
+
+template<typename T>
+void DLinkedList<T>::splice(Iterator pos, DLinkedList<T>& other, Iterator first, Iterator last, int count)
+{
+    // nothing to move, or the range is already right before pos (or pos starts it)
+    if (first == last || pos == last || pos == first)
+    {
+        return;
+    }
+
+    DNode<T>* firstNode = first.node();
+    DNode<T>* lastNode = last.node()->prev;   // the last node inside the range
+    DNode<T>* next = pos.node();
+
+    // "pull" the range out of its list
+    firstNode->prev->next = last.node();
+    last.node()->prev = firstNode->prev;
+
+    // and put it before pos
+    firstNode->prev = next->prev;
+    lastNode->next = next;
+
+    next->prev->next = firstNode;
+    next->prev = lastNode;
+
+    if (&other != this)
+    {
+        other.size_ -= count;
+        this->size_ += count;
+    }
 }
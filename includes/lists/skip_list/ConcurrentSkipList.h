@@ -0,0 +1,570 @@
+#pragma once
+
+#include "../../EpochReclaimer.h"
+#include "../../Random.h"
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+// a test can define CONCURRENT_SKIP_LIST_STEP(point, level) before including this header, to stop
+// a thread at the named points of an update and force an interleaving
+#ifndef CONCURRENT_SKIP_LIST_STEP
+#define CONCURRENT_SKIP_LIST_STEP(point, level)
+#endif
+
+/**
+ * A lock-free ordered map (Herlihy & Shavit / Fraser skip list).
+ * A node is removed logically by marking the lowest bit of its next pointers (top level first,
+ * level 0 last - the removal takes effect at level 0), and physically by the searches that snip
+ * marked nodes out. Unlinked nodes are deleted through the EpochReclaimer.
+ * insert, remove and find may run from many threads at once, they are linearizable.
+ * rangeScan is weakly consistent: it sees every key that stayed in the range during the scan.
+ * Keys are compared with operator< and operator==.
+ */
+template<typename K, typename V>
+class ConcurrentSkipList
+{
+public:
+	// Constructor
+
+	/**
+	 * @brief create an empty map.
+	 * @param maxHeight the maximal number of levels of a node (up to 64).
+	*/
+	explicit ConcurrentSkipList(int maxHeight = DEFAULT_MAX_HEIGHT);
+
+	/**
+	 * @brief delete all the nodes.
+	 * @note that no other thread may use the map anymore.
+	*/
+	~ConcurrentSkipList();
+
+	ConcurrentSkipList(const ConcurrentSkipList<K, V>& other) = delete;
+
+	ConcurrentSkipList<K, V>& operator=(const ConcurrentSkipList<K, V>& other) = delete;
+
+	// Operations
+
+	/**
+	 * @brief add a key and its value.
+	 * @return true iff the key was added, false if it was already in the map.
+	*/
+	bool insert(K key, V value);
+
+	/**
+	 * @brief remove a key and its value.
+	 * @return true iff this call removed the key.
+	*/
+	bool remove(K key);
+
+	/**
+	 * @brief look a key up.
+	 * @param value gets the key's value if it is found.
+	 * @return true iff the key is in the map.
+	*/
+	bool find(K key, V& value);
+
+	bool contains(K key);
+
+	/**
+	 * @brief call callback(key, value) for the keys in [lo, hi], in increasing order.
+	 * @return the number of keys visited.
+	*/
+	template<typename F>
+	int rangeScan(K lo, K hi, F callback);
+
+	// Getters
+
+	/**
+	 * @brief get the number of keys (exact only when no update is running).
+	*/
+	int size();
+
+	bool isEmpty();
+
+private:
+	/** A node and its tower of next words (a pointer and a removal mark). */
+	struct Node
+	{
+		K key;
+		V value;
+		int levels;
+		std::atomic<int> state;		// LINKED | REMOVED, the second to set its bit retires the node
+		std::atomic<uintptr_t>* next;
+
+		Node(int l)
+		{
+			levels = l;
+			state.store(0);
+			next = new std::atomic<uintptr_t>[l];
+		}
+
+		~Node()
+		{
+			delete[] next;
+		}
+	};
+
+	static const int DEFAULT_MAX_HEIGHT = 32;
+	static const int HEIGHT_LIMIT = 64;
+
+	static const int LINKED = 1;
+	static const int REMOVED = 2;
+
+	Node* head_;
+
+	Node* tail_;
+
+	int maxHeight_;
+
+	std::atomic<int> size_;
+
+	// Marked pointers
+
+	static Node* pointer(uintptr_t word);
+
+	static bool isMarked(uintptr_t word);
+
+	static uintptr_t makeWord(Node* node, bool marked);
+
+	// Helpers
+
+	int generateHeight();
+
+	/**
+	 * @brief find the last node before the key and the first node not before it in each level,
+	 * snipping out the removed nodes on the way.
+	 * @return true iff an unmarked node with the key is in level 0.
+	*/
+	bool findPath(K key, Node** preds, Node** succs);
+
+	/**
+	 * @brief one pass of findPath.
+	 * @param pastKey also walk past the unmarked nodes with the key, see snipRemoved.
+	 * @return false if a concurrent update got in the way and the pass should restart.
+	*/
+	bool tryFindPath(K key, Node** preds, Node** succs, bool pastKey = false);
+
+	/**
+	 * @brief snip the removed nodes with keys up to key out of every level, before one of them
+	 * is retired. an insertion of the same key may have linked its node in front of a removed
+	 * one in an upper level, so the search does not stop at an unmarked node with the key.
+	*/
+	void snipRemoved(K key);
+
+	/**
+	 * @brief find the first node in level 0 whose key is not less than key, without changing the list.
+	*/
+	Node* lowerBound(K key);
+
+	/**
+	 * @brief set a bit of the node's state, and retire it if the other bit is already set.
+	*/
+	void finish(Node* node, int bit);
+
+	static void deleteNode(void* node);
+};
+
+// Constructor
+
+template<typename K, typename V>
+ConcurrentSkipList<K, V>::ConcurrentSkipList(int maxHeight)
+{
+	if (maxHeight < 1 || maxHeight > HEIGHT_LIMIT)
+	{
+		throw std::invalid_argument("max. height should be between 1 and 64");
+	}
+
+	maxHeight_ = maxHeight;
+
+	head_ = new Node(maxHeight_);
+
+	tail_ = new Node(maxHeight_);
+
+	for (int level = 0; level < maxHeight_; level++)
+	{
+		head_->next[level].store(makeWord(tail_, false));
+		tail_->next[level].store(0);
+	}
+
+	size_.store(0);
+}
+
+template<typename K, typename V>
+ConcurrentSkipList<K, V>::~ConcurrentSkipList()
+{
+	Node* current = head_, * next;
+
+	// the removed nodes were unlinked and retired already, the others are all in level 0
+	while (current != tail_)
+	{
+		next = pointer(current->next[0].load());
+		delete current;
+		current = next;
+	}
+
+	delete tail_;
+
+	head_ = nullptr;
+	tail_ = nullptr;
+}
+
+// Operations
+
+template<typename K, typename V>
+bool ConcurrentSkipList<K, V>::insert(K key, V value)
+{
+	EpochReclaimer::Guard guard;
+
+	Node* preds[HEIGHT_LIMIT], * succs[HEIGHT_LIMIT];
+	Node* node = nullptr;
+	int levels = generateHeight();
+
+	while (true)
+	{
+		if (findPath(key, preds, succs))
+		{
+			delete node;
+			return false;
+		}
+
+		if (!node)
+		{
+			node = new Node(levels);
+			node->key = key;
+			node->value = value;
+		}
+
+		for (int level = 0; level < levels; level++)
+		{
+			node->next[level].store(makeWord(succs[level], false), std::memory_order_relaxed);
+		}
+
+		uintptr_t expected = makeWord(succs[0], false);
+
+		// linking level 0 is the linearization point of the insertion
+		if (preds[0]->next[0].compare_exchange_strong(expected, makeWord(node, false)))
+		{
+			break;
+		}
+	}
+
+	size_++;
+
+	// link the upper levels, unless the node is removed meanwhile
+	for (int level = 1; level < levels; level++)
+	{
+		bool linked = false;
+
+		while (!linked)
+		{
+			uintptr_t nextWord = node->next[level].load();
+
+			if (isMarked(nextWord))
+			{
+				break;
+			}
+
+			if (pointer(nextWord) != succs[level] &&
+				!node->next[level].compare_exchange_strong(nextWord, makeWord(succs[level], false)))
+			{
+				continue;
+			}
+
+			uintptr_t expected = makeWord(succs[level], false);
+
+			linked = preds[level]->next[level].compare_exchange_strong(expected, makeWord(node, false));
+
+			CONCURRENT_SKIP_LIST_STEP(insertLinked, linked ? level : -1);
+
+			// the neighbours changed, search again (this also tells if the node was removed)
+			if (!linked)
+			{
+				findPath(key, preds, succs);
+
+				if (succs[0] != node)
+				{
+					break;
+				}
+			}
+		}
+
+		if (!linked)
+		{
+			break;
+		}
+	}
+
+	// a removal that ran meanwhile may have missed the levels linked late, snip them now
+	if (isMarked(node->next[0].load()))
+	{
+		snipRemoved(key);
+	}
+
+	finish(node, LINKED);
+
+	return true;
+}
+
+template<typename K, typename V>
+bool ConcurrentSkipList<K, V>::remove(K key)
+{
+	EpochReclaimer::Guard guard;
+
+	Node* preds[HEIGHT_LIMIT], * succs[HEIGHT_LIMIT];
+
+	if (!findPath(key, preds, succs))
+	{
+		return false;
+	}
+
+	Node* victim = succs[0];
+
+	// mark the upper levels, top to bottom
+	for (int level = victim->levels - 1; level > 0; level--)
+	{
+		uintptr_t nextWord = victim->next[level].load();
+
+		while (!isMarked(nextWord))
+		{
+			victim->next[level].compare_exchange_weak(nextWord, nextWord | 1);
+		}
+	}
+
+	// marking level 0 is the linearization point, only one thread can do it
+	uintptr_t nextWord = victim->next[0].load();
+
+	while (true)
+	{
+		if (isMarked(nextWord))
+		{
+			return false;
+		}
+
+		if (victim->next[0].compare_exchange_weak(nextWord, nextWord | 1))
+		{
+			break;
+		}
+	}
+
+	size_--;
+
+	CONCURRENT_SKIP_LIST_STEP(removeMarked, 0);
+
+	// snip the node out of every level
+	snipRemoved(key);
+
+	finish(victim, REMOVED);
+
+	return true;
+}
+
+template<typename K, typename V>
+bool ConcurrentSkipList<K, V>::find(K key, V& value)
+{
+	EpochReclaimer::Guard guard;
+
+	Node* node = lowerBound(key);
+
+	if (node == tail_ || !(node->key == key))
+	{
+		return false;
+	}
+
+	value = node->value;
+
+	return true;
+}
+
+template<typename K, typename V>
+bool ConcurrentSkipList<K, V>::contains(K key)
+{
+	V value;
+
+	return find(key, value);
+}
+
+template<typename K, typename V>
+template<typename F>
+int ConcurrentSkipList<K, V>::rangeScan(K lo, K hi, F callback)
+{
+	EpochReclaimer::Guard guard;
+
+	int count = 0;
+	Node* node = lowerBound(lo);
+
+	// walk on level 0, skipping the removed nodes
+	while (node != tail_ && !(hi < node->key))
+	{
+		uintptr_t nextWord = node->next[0].load();
+
+		if (!isMarked(nextWord))
+		{
+			callback(node->key, node->value);
+			count++;
+		}
+
+		node = pointer(nextWord);
+	}
+
+	return count;
+}
+
+// Getters
+
+template<typename K, typename V>
+int ConcurrentSkipList<K, V>::size()
+{
+	return size_.load();
+}
+
+template<typename K, typename V>
+bool ConcurrentSkipList<K, V>::isEmpty()
+{
+	return size() == 0;
+}
+
+// PRIVATES
+
+template<typename K, typename V>
+inline typename ConcurrentSkipList<K, V>::Node* ConcurrentSkipList<K, V>::pointer(uintptr_t word)
+{
+	return reinterpret_cast<Node*>(word & ~(uintptr_t)1);
+}
+
+template<typename K, typename V>
+inline bool ConcurrentSkipList<K, V>::isMarked(uintptr_t word)
+{
+	return word & 1;
+}
+
+template<typename K, typename V>
+inline uintptr_t ConcurrentSkipList<K, V>::makeWord(Node* node, bool marked)
+{
+	return reinterpret_cast<uintptr_t>(node) | (marked ? 1 : 0);
+}
+
+template<typename K, typename V>
+int ConcurrentSkipList<K, V>::generateHeight()
+{
+	static thread_local FastRandom random;
+
+	int levels = 1 + FastRandom::trailingZeros(random.next());
+
+	return levels < maxHeight_ ? levels : maxHeight_;
+}
+
+template<typename K, typename V>
+bool ConcurrentSkipList<K, V>::findPath(K key, Node** preds, Node** succs)
+{
+	while (!tryFindPath(key, preds, succs))
+	{
+	}
+
+	return succs[0] != tail_ && succs[0]->key == key;
+}
+
+template<typename K, typename V>
+void ConcurrentSkipList<K, V>::snipRemoved(K key)
+{
+	Node* preds[HEIGHT_LIMIT], * succs[HEIGHT_LIMIT];
+
+	while (!tryFindPath(key, preds, succs, true))
+	{
+	}
+}
+
+template<typename K, typename V>
+bool ConcurrentSkipList<K, V>::tryFindPath(K key, Node** preds, Node** succs, bool pastKey)
+{
+	Node* pred = head_, * curr = nullptr, * succ = nullptr;
+
+	for (int level = maxHeight_ - 1; level >= 0; level--)
+	{
+		CONCURRENT_SKIP_LIST_STEP(findLevel, level);
+
+		curr = pointer(pred->next[level].load());
+
+		while (curr != tail_)
+		{
+			uintptr_t succWord = curr->next[level].load();
+
+			succ = pointer(succWord);
+
+			// curr is removed - snip it, which fails if pred changed or is removed too
+			if (isMarked(succWord))
+			{
+				uintptr_t expected = makeWord(curr, false);
+
+				if (!pred->next[level].compare_exchange_strong(expected, makeWord(succ, false)))
+				{
+					return false;
+				}
+
+				curr = succ;
+			}
+			else if (curr->key < key || (pastKey && !(key < curr->key)))
+			{
+				pred = curr;
+				curr = succ;
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		preds[level] = pred;
+		succs[level] = curr;
+	}
+
+	return true;
+}
+
+template<typename K, typename V>
+typename ConcurrentSkipList<K, V>::Node* ConcurrentSkipList<K, V>::lowerBound(K key)
+{
+	Node* pred = head_, * curr = nullptr;
+
+	for (int level = maxHeight_ - 1; level >= 0; level--)
+	{
+		curr = pointer(pred->next[level].load());
+
+		while (curr != tail_)
+		{
+			uintptr_t succWord = curr->next[level].load();
+
+			// step over removed nodes without snipping them
+			if (isMarked(succWord))
+			{
+				curr = pointer(succWord);
+			}
+			else if (curr->key < key)
+			{
+				pred = curr;
+				curr = pointer(succWord);
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+
+	return curr;
+}
+
+template<typename K, typename V>
+void ConcurrentSkipList<K, V>::finish(Node* node, int bit)
+{
+	if (node->state.fetch_or(bit) != 0)
+	{
+		EpochReclaimer::instance().retire(node, &ConcurrentSkipList<K, V>::deleteNode);
+	}
+}
+
+template<typename K, typename V>
+void ConcurrentSkipList<K, V>::deleteNode(void* node)
+{
+	delete static_cast<Node*>(node);
+}
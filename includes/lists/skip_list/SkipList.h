@@ -1,17 +1,93 @@
 #pragma once
 
 #include "SkipListNode.h"
-#include <random>
+#include "../../Random.h"
 #include <iostream>
 #include <climits>
 
 template<typename T>
 class SkipList
 {
+	// the size of the search paths kept on the stack (and in fingers)
+	static const int HEIGHT_LIMIT = 64;
+
 public:
+	/**
+	 * @brief a cursor over the keys in increasing order, end() is past the largest key.
+	 * moving forward is O(1), moving backward is O(1) with back links and O(log n) without them.
+	 * @note that a cursor stays valid until the node it points to is removed.
+	*/
+	class Iterator
+	{
+	public:
+		Iterator(SkipList<T>* list, SkipListNode<T>* node);
+
+		/** get the key under the cursor. */
+		T operator*() const;
+
+		Iterator& operator++();
+
+		Iterator operator++(int);
+
+		Iterator& operator--();
+
+		Iterator operator--(int);
+
+		bool operator==(const Iterator& other) const;
+
+		bool operator!=(const Iterator& other) const;
+
+	private:
+		SkipList<T>* list_;
+		SkipListNode<T>* node_;
+	};
+
+	/**
+	 * @brief a finger remembers the search path of the last key looked up through it, and the
+	 * next search resumes from that path instead of the head: it climbs only until the path
+	 * spans the new key, so a key at distance d from the previous one costs O(log d).
+	 * a finger is reset (to a search from the head) when the list was changed other than through it.
+	*/
+	class Finger
+	{
+	public:
+		Finger();
+
+	private:
+		friend class SkipList<T>;
+
+		const SkipList<T>* list_;
+
+		// the version of the list the path was found in
+		unsigned long long version_;
+
+		// the last node up to the key in each level, and its rank
+		SkipListNode<T>* path_[HEIGHT_LIMIT];
+		int ranks_[HEIGHT_LIMIT];
+	};
+
 	// Constructor
 
-	SkipList<T>(double prob = 0.5);
+	/**
+	 * @brief create an empty skip list.
+	 * @param prob the probability of a node to be promoted to the next level.
+	 * @param maxHeight the maximal number of levels of a node (up to 64).
+	 * @param backLinks whether the nodes keep back pointers (prev) in every level.
+	 * without them the nodes are smaller, and predecessor/maximum walk down from the head instead.
+	*/
+	SkipList<T>(double prob = 0.5, int maxHeight = DEFAULT_MAX_HEIGHT, bool backLinks = false);
+
+	~SkipList<T>();
+
+	SkipList(const SkipList<T>& other) = delete;
+
+	SkipList<T>& operator=(const SkipList<T>& other) = delete;
+
+	/**
+	 * @brief restart the height generator from a given seed, so the shape of the list is reproducible.
+	 * @param seed
+	*/
+	void seed(uint64_t seed);
 
 	// Operations
 
@@ -35,6 +111,69 @@ public:
 
 	T select(int index);
 
+	// Finger operations (see Finger)
+
+	SkipListNode<T>* find(T key, Finger& finger);
+
+	SkipListNode<T>* insert(T key, Finger& finger);
+
+	int rank(T key, Finger& finger);
+
+	T select(int index, Finger& finger);
+
+	// Bulk operations
+
+	/**
+	 * @brief replace the list's content with sorted keys, building all the levels and distances in one O(n) pass.
+	 * @param keys in non-decreasing order (repeated keys are added once).
+	 * @param n the number of keys.
+	*/
+	void buildFromSorted(const T* keys, int n);
+
+	/**
+	 * @brief insert a batch of keys. each search resumes from the path of the previous key,
+	 * so a sorted batch costs O(log d) per key, where d is the distance between consecutive keys.
+	 * an unsorted batch is still inserted correctly, by searching from the head when a key goes back.
+	 * @param keys
+	 * @param n the number of keys.
+	 * @return the number of keys added (the ones already in the list are skipped).
+	*/
+	int insertBatch(const T* keys, int n);
+
+	// Ranges
+
+	/**
+	 * @brief get a cursor to the smallest key.
+	*/
+	Iterator begin();
+
+	/**
+	 * @brief get a cursor past the largest key.
+	*/
+	Iterator end();
+
+	/**
+	 * @brief get a cursor to the first key that is not less than key (or end()).
+	*/
+	Iterator lowerBound(T key);
+
+	/**
+	 * @brief get a cursor to the first key that is greater than key (or end()).
+	*/
+	Iterator upperBound(T key);
+
+	/**
+	 * @brief count the keys in [lo, hi] in O(log n), using the distances between the nodes.
+	*/
+	int rangeCount(T lo, T hi);
+
+	/**
+	 * @brief call callback(key) for each key in [lo, hi] in increasing order, walking on level 0.
+	 * @return the number of keys visited.
+	*/
+	template<typename F>
+	int rangeScan(T lo, T hi, F callback);
+
 	// Getters
 
 	bool isEmpty();
@@ -54,28 +193,186 @@ private:
 
 	double prob_;
 
+	// promoting when a random word is below the threshold happens with probability prob_
+	uint64_t promoteThreshold_;
+
+	int maxHeight_;
+
+	bool backLinks_;
+
+	FastRandom random_;
+
+	// counts the changes in the list's structure, so fingers know when their path is stale
+	unsigned long long version_;
+
+	static const int DEFAULT_MAX_HEIGHT = 32;
+
 	void increaseHeight();
 
 	void decreaseHeight();
 
+	/**
+	 * @brief generate the number of levels for a new node.
+	*/
 	int generateHeight();
+
+	/**
+	 * @brief find, in every level, the last node before a key and its rank.
+	 * @param key
+	 * @param inclusive whether nodes holding the key itself count as before it.
+	 * @param path gets the last node in each level (the head if there is none).
+	 * @param ranks gets the rank of the node in each level (the head's rank is 0), may be nullptr.
+	 * @return the last node before the key in level 0.
+	*/
+	SkipListNode<T>* findPath(T key, bool inclusive, SkipListNode<T>** path, int* ranks);
+
+	/**
+	 * @brief like findPath, but start at path[top] (of rank ranks[top]) and keep the path above top as is.
+	*/
+	SkipListNode<T>* findPathFrom(T key, bool inclusive, int top, SkipListNode<T>** path, int* ranks);
+
+	/**
+	 * @brief link a new node right after path[0], given the inclusive search path of its key and its ranks.
+	 * the path then leads to the new node, so it can be reused for the next (greater) key.
+	*/
+	SkipListNode<T>* link(T key, SkipListNode<T>** path, int* ranks);
+
+	/**
+	 * @brief remove all the nodes and get back to a single empty level.
+	*/
+	void clear();
+
+	/**
+	 * @brief bring a finger to the inclusive search path of a key.
+	 * @return the last node up to the key in level 0.
+	*/
+	SkipListNode<T>* seek(T key, Finger& finger);
+
+	/**
+	 * @brief reset a finger that belongs to another list or to an older version of this list.
+	 * @return the lowest level of its path that may be used (the top level after a reset).
+	*/
+	int validate(Finger& finger);
 };
 
 template<typename T>
-SkipList<T>::SkipList(double prob)
+SkipList<T>::SkipList(double prob, int maxHeight, bool backLinks)
 {
-	head_ = new SkipListNode<T>();
+	if (prob <= 0 || prob >= 1)
+	{
+		throw std::invalid_argument("cannot have non-positive probability");
+	}
+
+	if (maxHeight < 1 || maxHeight > HEIGHT_LIMIT)
+	{
+		throw std::invalid_argument("max. height should be between 1 and 64");
+	}
 
-	tail_ = new SkipListNode<T>();
+	maxHeight_ = maxHeight;
+
+	backLinks_ = backLinks;
+
+	// the sentinels are as tall as the tallest possible node
+	head_ = SkipListNode<T>::createSentinel(maxHeight_, backLinks_);
+
+	tail_ = SkipListNode<T>::createSentinel(maxHeight_, backLinks_);
 
 	size_ = 0;
 
-	if (prob <= 0 || prob >= 1)
+	version_ = 0;
+
+	prob_ = prob;
+
+	promoteThreshold_ = (uint64_t)(prob * 18446744073709551616.0);
+
+	increaseHeight();
+}
+
+template<typename T>
+SkipList<T>::~SkipList()
+{
+	SkipListNode<T>* current = head_, * next;
+
+	// the tail is the last node in level 0
+	while (current)
 	{
-		throw std::invalid_argument("cannot have non-positive probability");
+		next = current->getNext(0);
+		SkipListNode<T>::destroy(current);
+		current = next;
 	}
 
-	prob_ = prob;
+	head_ = nullptr;
+	tail_ = nullptr;
+	size_ = 0;
+}
+
+template<typename T>
+void SkipList<T>::seed(uint64_t seed)
+{
+	random_.seed(seed);
+}
+
+template<typename T>
+SkipListNode<T>* SkipList<T>::seek(T key, Finger& finger)
+{
+	SkipListNode<T>** path = finger.path_;
+	int top = head_->getHeight(), level = validate(finger);
+
+	// a level is right for the key when its node is not past the key and its next node is,
+	// and then all the levels above it are right too
+	while (level < top && !((path[level] == head_ || path[level]->getKey() <= key) &&
+		(path[level]->getNext(level) == tail_ || key < path[level]->getNext(level)->getKey())))
+	{
+		level++;
+	}
+
+	if (path[level] != head_ && key < path[level]->getKey())
+	{
+		path[level] = head_;
+		finger.ranks_[level] = 0;
+	}
+
+	return findPathFrom(key, true, level, path, finger.ranks_);
+}
+
+template<typename T>
+int SkipList<T>::validate(Finger& finger)
+{
+	int top = head_->getHeight();
+
+	if (finger.list_ != this || finger.version_ != version_)
+	{
+		finger.list_ = this;
+		finger.version_ = version_;
+
+		finger.path_[top] = head_;
+		finger.ranks_[top] = 0;
+
+		return top;
+	}
+
+	return 0;
+}
+
+template<typename T>
+void SkipList<T>::clear()
+{
+	SkipListNode<T>* current = head_->getNext(0), * next;
+
+	while (current != tail_)
+	{
+		next = current->getNext(0);
+		SkipListNode<T>::destroy(current);
+		current = next;
+	}
+
+	while (head_->getHeight() >= 0)
+	{
+		decreaseHeight();
+	}
+
+	size_ = 0;
+	version_++;
 
 	increaseHeight();
 }
@@ -99,19 +396,67 @@ void SkipList<T>::decreaseHeight()
 template<typename T>
 int SkipList<T>::generateHeight()
 {
-	const int limit = INT_MAX;
-	int counter = 1;
+	int counter;
 
-	std::random_device rnd;
-	std::mt19937 twister(rnd());
-	std::uniform_int_distribution<> dist(0, limit);
+	// with probability 1/2 every trailing zero of a random word is one more promotion
+	if (prob_ == 0.5)
+	{
+		counter = 1 + FastRandom::trailingZeros(random_.next());
+	}
+	else
+	{
+		counter = 1;
 
-	while (dist(twister) <= limit * prob_)
+		while (counter < maxHeight_ && random_.next() < promoteThreshold_)
+		{
+			counter++;
+		}
+	}
+
+	return counter < maxHeight_ ? counter : maxHeight_;
+}
+
+template<typename T>
+SkipListNode<T>* SkipList<T>::findPath(T key, bool inclusive, SkipListNode<T>** path, int* ranks)
+{
+	int top = head_->getHeight();
+
+	path[top] = head_;
+
+	if (ranks)
 	{
-		counter++;
+		ranks[top] = 0;
+	}
+
+	return findPathFrom(key, inclusive, top, path, ranks);
+}
+
+template<typename T>
+SkipListNode<T>* SkipList<T>::findPathFrom(T key, bool inclusive, int top, SkipListNode<T>** path, int* ranks)
+{
+	SkipListNode<T>* node = path[top], * next = nullptr;
+	int rank = ranks ? ranks[top] : 0;
+
+	for (int level = top; 0 <= level; level--)
+	{
+		next = node->getNext(level);
+
+		while (next != tail_ && (inclusive ? next->getKey() <= key : next->getKey() < key))
+		{
+			rank += node->getDist(level);
+			node = next;
+			next = node->getNext(level);
+		}
+
+		path[level] = node;
+
+		if (ranks)
+		{
+			ranks[level] = rank;
+		}
 	}
 
-	return counter;
+	return node;
 }
 
 template<typename T>
@@ -119,7 +464,8 @@ SkipListNode<T>* SkipList<T>::find(T key)
 {
 	SkipListNode<T>* node = search(key);
 
-	return (isEmpty() || node->getKey() != key) ? nullptr : node;
+	// search gives no node for an empty list or a key below all the keys
+	return (node == nullptr || node->getKey() != key) ? nullptr : node;
 }
 
 template<typename T>
@@ -146,169 +492,301 @@ SkipListNode<T>* SkipList<T>::search(T key)
 template<typename T>
 SkipListNode<T>* SkipList<T>::insert(T key)
 {
-	int nodeHeight = generateHeight(), oldHeight = head_->getHeight();
-	
-	int distanceAtLevel = 0;
+	SkipListNode<T>* path[HEIGHT_LIMIT];
+	int ranks[HEIGHT_LIMIT];
+
+	SkipListNode<T>* prevNode = findPath(key, true, path, ranks);
+
+	// the key is already in the list
+	if (prevNode != head_ && prevNode->getKey() == key)
+	{
+		return nullptr;
+	}
+
+	return link(key, path, ranks);
+}
 
-	SkipListNode<T>* prevNode = nullptr, *nextNode = nullptr, *newNode = nullptr;
+template<typename T>
+SkipListNode<T>* SkipList<T>::link(T key, SkipListNode<T>** path, int* ranks)
+{
+	SkipListNode<T>* prevNode = nullptr, * newNode = nullptr, * nextNode = nullptr;
 
-	SkipListNode<T>* current = nullptr, *shorter = nullptr, *prevAtLevel = nullptr;
+	int levels = generateHeight(), oldHeight = head_->getHeight();
 
 	// if the new node is taller than all the existing nodes, increase the list's height
-	for (int i = oldHeight; i < nodeHeight; i++)
+	for (int level = oldHeight + 1; level < levels; level++)
 	{
 		increaseHeight();
+
+		// the distance between the sentinels is the num. of elements (size) + 1
+		head_->setDist(level, size_ + 1);
+
+		path[level] = head_;
+		ranks[level] = 0;
 	}
 
-	// if the height of the list increased, update the distances between the sentinels
-	if (oldHeight < nodeHeight)
+	newNode = SkipListNode<T>::create(key, levels, backLinks_);
+
+	// the new node's rank is one after the node before it in level 0
+	int newRank = ranks[0] + 1;
+
+	for (int level = 0; level < levels; level++)
 	{
-		for (int i = oldHeight + 1; i <= nodeHeight; i++)
-		{
-			// the distance between the sentinels is the num. of elements (size) + 1
-			head_->setDist(i, size_ + 1);
-		}
-	}
+		prevNode = path[level];
+		nextNode = prevNode->getNext(level);
+
+		newNode->setNext(level, nextNode);
+		newNode->setPrev(level, prevNode);
+		prevNode->setNext(level, newNode);
+		nextNode->setPrev(level, newNode);
 
-	prevNode = search(key);
+		// the next node's rank grows by one, so its distance from the new node is the old jump minus the part before the new node
+		newNode->setDist(level, ranks[level] + prevNode->getDist(level) + 1 - newRank);
+		prevNode->setDist(level, newRank - ranks[level]);
 
-	if (prevNode == nullptr)
+		// the new node is now the last node up to its key in this level
+		path[level] = newNode;
+		ranks[level] = newRank;
+	}
+
+	// the jumps above the new node pass over one more node
+	for (int level = levels; level <= head_->getHeight(); level++)
 	{
-		prevNode = head_;
+		path[level]->setDist(level, path[level]->getDist(level) + 1);
 	}
-	// the key is already in the list
-	else if (prevNode->getKey() == key)
+
+	size_++;
+	version_++;
+
+	return newNode;
+}
+
+// Finger operations
+
+template<typename T>
+SkipListNode<T>* SkipList<T>::find(T key, Finger& finger)
+{
+	SkipListNode<T>* node = seek(key, finger);
+
+	return (node != head_ && node->getKey() == key) ? node : nullptr;
+}
+
+template<typename T>
+SkipListNode<T>* SkipList<T>::insert(T key, Finger& finger)
+{
+	SkipListNode<T>* prevNode = seek(key, finger);
+
+	if (prevNode != head_ && prevNode->getKey() == key)
 	{
 		return nullptr;
 	}
 
-	newNode = new SkipListNode<T>(key);
+	SkipListNode<T>* node = link(key, finger.path_, finger.ranks_);
 
-	for (int level = 0; level <= nodeHeight && prevNode; level++)
-	{
-		nextNode =  prevNode->getNext(level);
+	// link left the path on the new node, so this finger stays valid
+	finger.version_ = version_;
 
-		newNode->addLevel(prevNode, nextNode);
-		prevNode->setNext(level, newNode);
-		nextNode->setPrev(level, newNode);
+	return node;
+}
 
-		// if the current level is the max. level of prevNode, move left until arriving at a higher node or the sentinel
-		while (prevNode && prevNode->getHeight() == level)
-		{
-			prevNode = prevNode->getPrev(level);
-		}
+template<typename T>
+int SkipList<T>::rank(T key, Finger& finger)
+{
+	seek(key, finger);
+
+	return finger.ranks_[0];
+}
+
+template<typename T>
+T SkipList<T>::select(int index, Finger& finger)
+{
+	if (index < 0 || index >= size_)
+	{
+		throw std::out_of_range("index out of range");
 	}
 
-	/** UPDATE THE DISTANCES */
+	SkipListNode<T>** path = finger.path_;
+	int* ranks = finger.ranks_;
+	int position = index + 1, top = head_->getHeight(), level = validate(finger);
 
-	newNode->setDist(0, 1);
+	// climb until the jump from the path spans the position
+	while (level < top && !(ranks[level] <= position && position < ranks[level] + path[level]->getDist(level)))
+	{
+		level++;
+	}
 
-	// update the distances for each level from level 1 to the top
-	for (int level = 1; level <= nodeHeight; level++)
+	if (position < ranks[level])
 	{
-		distanceAtLevel = 0;
-		current = newNode;
+		path[level] = head_;
+		ranks[level] = 0;
+	}
+
+	SkipListNode<T>* node = path[level];
+	int rank = ranks[level];
 
-		// walk on the level beneath the current level
-		// the jumps/skips are longer at higher levels
-		while (current != newNode->getNext(level))
+	for (; 0 <= level; level--)
+	{
+		while (rank + node->getDist(level) <= position)
 		{
-			distanceAtLevel += current->getDist(level - 1);
-			current = current->getNext(level - 1);
+			rank += node->getDist(level);
+			node = node->getNext(level);
 		}
 
-		newNode->setDist(level, distanceAtLevel);
+		path[level] = node;
+		ranks[level] = rank;
 	}
 
-	// update the distances in the nodes before the new one
+	return node->getKey();
+}
 
-	newNode->getPrev(0)->setDist(0, 1);
+// Bulk operations
 
-	// update the distances of the nodes before the new one, up to the height of the new node
-	for (int level = 1; level <= nodeHeight; level++)
+template<typename T>
+void SkipList<T>::buildFromSorted(const T* keys, int n)
+{
+	if (n < 0)
 	{
-		prevAtLevel = newNode->getPrev(level);
+		throw std::invalid_argument("length cannot be negative");
+	}
 
-		// put the new node in the middle of the prev and the then-next of the prev node
-		prevAtLevel->setDist(level, prevAtLevel->getDist(level) - newNode->getDist(level) + 1);
+	for (int i = 1; i < n; i++)
+	{
+		if (keys[i] < keys[i - 1])
+		{
+			throw std::invalid_argument("the keys are not sorted");
+		}
 	}
 
-	// update the distances of the taller nodes before the new one
+	clear();
+
+	// the last node linked in each level, and its rank
+	SkipListNode<T>* last[HEIGHT_LIMIT];
+	int lastRanks[HEIGHT_LIMIT];
 
-	current = newNode;
-	shorter = newNode;
+	last[0] = head_;
+	lastRanks[0] = 0;
 
-	// the head is always the highest node
-	while (current != head_)
+	for (int i = 0; i < n; i++)
 	{
-		// find the first (but we go backwards) node higher than the current node
-		while (current != head_ && current->getHeight() <= shorter->getHeight())
+		if (i > 0 && keys[i] == keys[i - 1])
 		{
-			current = current->getPrev(current->getHeight());
+			continue;
 		}
 
-		// add one to the distance in each layer of the node above the new one
-		for (int level = shorter->getHeight() + 1; level <= current->getHeight(); level++)
+		int levels = generateHeight(), rank = size_ + 1;
+
+		for (int level = head_->getHeight() + 1; level < levels; level++)
 		{
-			current->setDist(level, current->getDist(level) + 1);
+			increaseHeight();
+
+			last[level] = head_;
+			lastRanks[level] = 0;
 		}
 
-		shorter = current;
-	}
+		SkipListNode<T>* node = SkipListNode<T>::create(keys[i], levels, backLinks_);
 
-	size_++;
+		// append the node to the end of each of its levels
+		for (int level = 0; level < levels; level++)
+		{
+			last[level]->setNext(level, node);
+			last[level]->setDist(level, rank - lastRanks[level]);
+			node->setPrev(level, last[level]);
 
-	return newNode;
+			last[level] = node;
+			lastRanks[level] = rank;
+		}
+
+		size_++;
+	}
+
+	// close every level with the tail
+	for (int level = 0; level <= head_->getHeight(); level++)
+	{
+		last[level]->setNext(level, tail_);
+		last[level]->setDist(level, size_ + 1 - lastRanks[level]);
+		tail_->setPrev(level, last[level]);
+	}
 }
 
 template<typename T>
-bool SkipList<T>::remove(T key)
+int SkipList<T>::insertBatch(const T* keys, int n)
 {
-	SkipListNode<T>* node = find(key), *prev = nullptr, * next = nullptr;
-	SkipListNode<T>* current = nullptr, * shorter = nullptr;
+	SkipListNode<T>* path[HEIGHT_LIMIT];
+	int ranks[HEIGHT_LIMIT];
+	int added = 0;
 
-	if (!node)
+	for (int i = 0; i < n; i++)
 	{
-		return false;
-	}
+		T key = keys[i];
+		SkipListNode<T>* prevNode;
 
-	for (int level = 0; level <= node->getHeight(); level++)
-	{
-		prev = node->getPrev(level);
-		next = node->getNext(level);
+		if (i == 0 || key < keys[i - 1])
+		{
+			prevNode = findPath(key, true, path, ranks);
+		}
+		else
+		{
+			int level = 0, top = head_->getHeight();
+
+			// climb the previous path while its next node is still not past the key,
+			// the path above that level is already right for this key too
+			while (level < top && path[level + 1]->getNext(level + 1) != tail_ &&
+				path[level + 1]->getNext(level + 1)->getKey() <= key)
+			{
+				level++;
+			}
 
-		prev->setNext(level, next);
-		next->setPrev(level, prev);
+			prevNode = findPathFrom(key, true, level, path, ranks);
+		}
+
+		if (prevNode != head_ && prevNode->getKey() == key)
+		{
+			continue;
+		}
 
-		prev->setDist(level, prev->getDist(level) + node->getDist(level) - 1);
+		link(key, path, ranks);
+		added++;
 	}
 
-	// update the distances of the taller nodes before the new one
+	return added;
+}
 
-	current = node;
-	shorter = node;
+template<typename T>
+bool SkipList<T>::remove(T key)
+{
+	SkipListNode<T>* path[HEIGHT_LIMIT];
+
+	SkipListNode<T>* node = findPath(key, false, path, nullptr)->getNext(0), * prev = nullptr;
 
-	// the head is always the highest node
-	while (current != head_)
+	if (node == tail_ || node->getKey() != key)
 	{
-		// find the first (but we go backwards) node higher than the current node
-		while (current != head_ && current->getHeight() <= shorter->getHeight())
+		return false;
+	}
+
+	for (int level = 0; level <= head_->getHeight(); level++)
+	{
+		prev = path[level];
+
+		if (level <= node->getHeight())
 		{
-			current = current->getPrev(current->getHeight());
-		}
+			prev->setNext(level, node->getNext(level));
+			node->getNext(level)->setPrev(level, prev);
 
-		// subtract one to the distance in each layer of the node above the new one
-		for (int level = shorter->getHeight() + 1; level <= current->getHeight(); level++)
+			prev->setDist(level, prev->getDist(level) + node->getDist(level) - 1);
+		}
+		// the jumps above the node pass over one less node
+		else
 		{
-			current->setDist(level, current->getDist(level) - 1);
+			prev->setDist(level, prev->getDist(level) - 1);
 		}
-
-		shorter = current;
 	}
 
+	SkipListNode<T>::destroy(node);
+
 	size_--;
+	version_++;
 
-	while (head_->getNext(head_->getHeight()) == tail_ && !(size_ == 0 && head_->getHeight() == 0))
+	while (head_->getHeight() > 0 && head_->getNext(head_->getHeight()) == tail_)
 	{
 		decreaseHeight();
 	}
@@ -319,19 +797,21 @@ bool SkipList<T>::remove(T key)
 template<typename T>
 T SkipList<T>::predecessor(T key)
 {
-	SkipListNode<T>* node = find(key);
+	SkipListNode<T>* path[HEIGHT_LIMIT];
 
-	if (!node)
+	SkipListNode<T>* prev = findPath(key, false, path, nullptr), * node = prev->getNext(0);
+
+	if (node == tail_ || node->getKey() != key)
 	{
 		throw std::invalid_argument("this key is not in the list");
 	}
 
-	if (node->getPrev(0) == head_)
+	if (prev == head_)
 	{
 		throw std::out_of_range("this node has no predecessor");
 	}
 
-	return node->getPrev(0)->getKey();
+	return prev->getKey();
 }
 
 template<typename T>
@@ -371,7 +851,23 @@ T SkipList<T>::maximum()
 		throw std::logic_error("the list is empty");
 	}
 
-	return tail_->getPrev(0)->getKey();
+	if (backLinks_)
+	{
+		return tail_->getPrev(0)->getKey();
+	}
+
+	SkipListNode<T>* node = head_;
+
+	// walk as far as possible in each level
+	for (int level = head_->getHeight(); 0 <= level; level--)
+	{
+		while (node->getNext(level) != tail_)
+		{
+			node = node->getNext(level);
+		}
+	}
+
+	return node->getKey();
 }
 
 template<typename T>
@@ -385,7 +881,7 @@ int SkipList<T>::rank(T key)
 	{
 		// while the next node is less than or is the value we look for,
 		// walk on that layer and sum the distances
-		while (node->getNext(level) != nullptr && node->getNext(level)->getKey() <= key) {
+		while (node->getNext(level) != tail_ && node->getNext(level)->getKey() <= key) {
 			rank += node->getDist(level);
 			node = node->getNext(level);
 		}
@@ -406,7 +902,7 @@ T SkipList<T>::select(int index)
 
 	SkipListNode<T>* current = head_;
 
-	int level = current->getHeight(), leftToWalk = index;
+	int level = current->getHeight(), leftToWalk = index + 1;
 
 	while (leftToWalk)
 	{
@@ -425,6 +921,156 @@ T SkipList<T>::select(int index)
 	return current->getKey();
 }
 
+// Ranges
+
+template<typename T>
+typename SkipList<T>::Iterator SkipList<T>::begin()
+{
+	return Iterator(this, head_->getNext(0));
+}
+
+template<typename T>
+typename SkipList<T>::Iterator SkipList<T>::end()
+{
+	return Iterator(this, tail_);
+}
+
+template<typename T>
+typename SkipList<T>::Iterator SkipList<T>::lowerBound(T key)
+{
+	SkipListNode<T>* path[HEIGHT_LIMIT];
+
+	return Iterator(this, findPath(key, false, path, nullptr)->getNext(0));
+}
+
+template<typename T>
+typename SkipList<T>::Iterator SkipList<T>::upperBound(T key)
+{
+	SkipListNode<T>* path[HEIGHT_LIMIT];
+
+	return Iterator(this, findPath(key, true, path, nullptr)->getNext(0));
+}
+
+template<typename T>
+int SkipList<T>::rangeCount(T lo, T hi)
+{
+	if (hi < lo)
+	{
+		return 0;
+	}
+
+	SkipListNode<T>* path[HEIGHT_LIMIT];
+	int ranks[HEIGHT_LIMIT];
+
+	// (the number of keys up to hi) - (the number of keys less than lo)
+	findPath(lo, false, path, ranks);
+
+	return rank(hi) - ranks[0];
+}
+
+template<typename T>
+template<typename F>
+int SkipList<T>::rangeScan(T lo, T hi, F callback)
+{
+	SkipListNode<T>* path[HEIGHT_LIMIT];
+
+	SkipListNode<T>* node = findPath(lo, false, path, nullptr)->getNext(0);
+	int count = 0;
+
+	while (node != tail_ && node->getKey() <= hi)
+	{
+		callback(node->getKey());
+		count++;
+
+		node = node->getNext(0);
+	}
+
+	return count;
+}
+
+// Finger
+
+template<typename T>
+SkipList<T>::Finger::Finger()
+{
+	list_ = nullptr;
+	version_ = 0;
+}
+
+// Iterator
+
+template<typename T>
+SkipList<T>::Iterator::Iterator(SkipList<T>* list, SkipListNode<T>* node)
+{
+	list_ = list;
+	node_ = node;
+}
+
+template<typename T>
+inline T SkipList<T>::Iterator::operator*() const
+{
+	return node_->getKey();
+}
+
+template<typename T>
+inline typename SkipList<T>::Iterator& SkipList<T>::Iterator::operator++()
+{
+	node_ = node_->getNext(0);
+	return *this;
+}
+
+template<typename T>
+inline typename SkipList<T>::Iterator SkipList<T>::Iterator::operator++(int)
+{
+	Iterator old = *this;
+	node_ = node_->getNext(0);
+	return old;
+}
+
+template<typename T>
+typename SkipList<T>::Iterator& SkipList<T>::Iterator::operator--()
+{
+	SkipListNode<T>* path[HEIGHT_LIMIT];
+
+	if (list_->backLinks_)
+	{
+		node_ = node_->getPrev(0);
+	}
+	// the node before the tail is the last one with the maximal key
+	else if (node_ == list_->tail_)
+	{
+		node_ = list_->isEmpty() ? list_->head_ : list_->findPath(list_->maximum(), true, path, nullptr);
+	}
+	else
+	{
+		node_ = list_->findPath(node_->getKey(), false, path, nullptr);
+	}
+
+	return *this;
+}
+
+template<typename T>
+inline typename SkipList<T>::Iterator SkipList<T>::Iterator::operator--(int)
+{
+	Iterator old = *this;
+	operator--();
+	return old;
+}
+
+template<typename T>
+inline bool SkipList<T>::Iterator::operator==(const Iterator& other) const
+{
+	return node_ == other.node_;
+}
+
+template<typename T>
+inline bool SkipList<T>::Iterator::operator!=(const Iterator& other) const
+{
+	return node_ != other.node_;
+}
+
+// Getters
+
 template<typename T>
 bool SkipList<T>::isEmpty()
 {
@@ -0,0 +1,468 @@
+#pragma once
+
+#include "../../Random.h"
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <stdexcept>
+
+/**
+ * An ordered map on a skip list, with order statistics (rank and select).
+ * Each node holds its key, its value and its tower of levels in one allocation.
+ * Keys are compared only through Compare (a strict weak order, std::less by default),
+ * two keys are the same when neither is less than the other.
+ */
+template<typename K, typename V, typename Compare = std::less<K> >
+class SkipListMap
+{
+public:
+	// Constructor
+
+	/**
+	 * @brief create an empty map.
+	 * @param compare the comparator of the keys.
+	*/
+	explicit SkipListMap(Compare compare = Compare());
+
+	~SkipListMap();
+
+	SkipListMap(const SkipListMap& other) = delete;
+
+	SkipListMap& operator=(const SkipListMap& other) = delete;
+
+	/**
+	 * @brief restart the height generator from a given seed, so the shape of the map is reproducible.
+	 * @param seed
+	*/
+	void seed(uint64_t seed);
+
+	// Operations
+
+	/**
+	 * @brief add a key and its value.
+	 * @return true iff the key was added, false if it was already in the map (and its value is kept).
+	*/
+	bool insert(K key, V value);
+
+	/**
+	 * @brief set the value of a key, adding the key if it is not in the map.
+	*/
+	void set(K key, V value);
+
+	/**
+	 * @brief look a key up.
+	 * @return a pointer to the key's value, or nullptr if the key is not in the map.
+	*/
+	V* search(K key);
+
+	/**
+	 * @brief get the value of a key.
+	 * @throw std::invalid_argument if the key is not in the map.
+	*/
+	V get(K key);
+
+	bool contains(K key);
+
+	/**
+	 * @brief remove a key and its value.
+	 * @return true iff the key was in the map.
+	*/
+	bool remove(K key);
+
+	/**
+	 * @brief get the number of keys that are not greater than key.
+	*/
+	int rank(K key);
+
+	/**
+	 * @brief get the key in a given place in the order (starting from 0).
+	*/
+	K select(int index);
+
+	/**
+	 * @brief get the value of the key in a given place in the order (starting from 0).
+	*/
+	V& valueAt(int index);
+
+	// Getters
+
+	int size();
+
+	bool isEmpty();
+
+private:
+	struct Node;
+
+	/** A level in a tower - the next node on this level and the number of level 0 steps to it. */
+	struct Level
+	{
+		Node* next;
+		int dist;
+	};
+
+	/** A key, its value and (right after them in memory) its tower. */
+	struct Node
+	{
+		K key;
+		V value;
+		int levels;
+
+		Node(K k, V v, int l) : key(k), value(v), levels(l)
+		{
+		}
+
+		Level* tower()
+		{
+			return reinterpret_cast<Level*>(reinterpret_cast<char*>(this) + towerOffset());
+		}
+	};
+
+	static const int MAX_HEIGHT = 32;
+
+	// the head's tower, a null next is the end of a level
+	Level head_[MAX_HEIGHT];
+
+	// the number of levels in use
+	int height_;
+
+	int size_;
+
+	Compare compare_;
+
+	FastRandom random_;
+
+	static size_t towerOffset();
+
+	static Node* createNode(K key, V value, int levels);
+
+	static void destroyNode(Node* node);
+
+	int generateHeight();
+
+	bool same(const K& a, const K& b);
+
+	/**
+	 * @brief find, in every level, the level of the last node before the key and its rank.
+	 * @return the first node that is not before the key (nullptr if there is none).
+	*/
+	Node* findPath(const K& key, Level** path, int* ranks);
+
+	/**
+	 * @brief find the node in a given place in the order (starting from 1).
+	*/
+	Node* nodeAt(int position);
+
+	Node* link(K key, V value, Level** path, int* ranks);
+};
+
+// Constructor
+
+template<typename K, typename V, typename Compare>
+SkipListMap<K, V, Compare>::SkipListMap(Compare compare) : compare_(compare)
+{
+	for (int level = 0; level < MAX_HEIGHT; level++)
+	{
+		head_[level].next = nullptr;
+		head_[level].dist = 1;
+	}
+
+	height_ = 1;
+	size_ = 0;
+}
+
+template<typename K, typename V, typename Compare>
+SkipListMap<K, V, Compare>::~SkipListMap()
+{
+	Node* current = head_[0].next, * next;
+
+	while (current)
+	{
+		next = current->tower()[0].next;
+		destroyNode(current);
+		current = next;
+	}
+
+	size_ = 0;
+}
+
+template<typename K, typename V, typename Compare>
+void SkipListMap<K, V, Compare>::seed(uint64_t seed)
+{
+	random_.seed(seed);
+}
+
+// Operations
+
+template<typename K, typename V, typename Compare>
+bool SkipListMap<K, V, Compare>::insert(K key, V value)
+{
+	Level* path[MAX_HEIGHT];
+	int ranks[MAX_HEIGHT];
+
+	Node* node = findPath(key, path, ranks);
+
+	if (node && same(node->key, key))
+	{
+		return false;
+	}
+
+	link(key, value, path, ranks);
+
+	return true;
+}
+
+template<typename K, typename V, typename Compare>
+void SkipListMap<K, V, Compare>::set(K key, V value)
+{
+	Level* path[MAX_HEIGHT];
+	int ranks[MAX_HEIGHT];
+
+	Node* node = findPath(key, path, ranks);
+
+	if (node && same(node->key, key))
+	{
+		node->value = value;
+	}
+	else
+	{
+		link(key, value, path, ranks);
+	}
+}
+
+template<typename K, typename V, typename Compare>
+V* SkipListMap<K, V, Compare>::search(K key)
+{
+	Level* path[MAX_HEIGHT];
+
+	Node* node = findPath(key, path, nullptr);
+
+	return (node && same(node->key, key)) ? &node->value : nullptr;
+}
+
+template<typename K, typename V, typename Compare>
+V SkipListMap<K, V, Compare>::get(K key)
+{
+	V* value = search(key);
+
+	if (!value)
+	{
+		throw std::invalid_argument("this key is not in the map");
+	}
+
+	return *value;
+}
+
+template<typename K, typename V, typename Compare>
+bool SkipListMap<K, V, Compare>::contains(K key)
+{
+	return search(key) != nullptr;
+}
+
+template<typename K, typename V, typename Compare>
+bool SkipListMap<K, V, Compare>::remove(K key)
+{
+	Level* path[MAX_HEIGHT];
+
+	Node* node = findPath(key, path, nullptr);
+
+	if (!node || !same(node->key, key))
+	{
+		return false;
+	}
+
+	for (int level = 0; level < height_; level++)
+	{
+		if (level < node->levels)
+		{
+			path[level]->next = node->tower()[level].next;
+			path[level]->dist += node->tower()[level].dist - 1;
+		}
+		// the jumps above the node pass over one less node
+		else
+		{
+			path[level]->dist--;
+		}
+	}
+
+	destroyNode(node);
+
+	size_--;
+
+	while (height_ > 1 && !head_[height_ - 1].next)
+	{
+		height_--;
+	}
+
+	return true;
+}
+
+template<typename K, typename V, typename Compare>
+int SkipListMap<K, V, Compare>::rank(K key)
+{
+	Level* tower = head_;
+	int rank = 0;
+
+	for (int level = height_ - 1; 0 <= level; level--)
+	{
+		// walk while the next key is not greater than the key
+		while (tower[level].next && !compare_(key, tower[level].next->key))
+		{
+			rank += tower[level].dist;
+			tower = tower[level].next->tower();
+		}
+	}
+
+	return rank;
+}
+
+template<typename K, typename V, typename Compare>
+K SkipListMap<K, V, Compare>::select(int index)
+{
+	return nodeAt(index + 1)->key;
+}
+
+template<typename K, typename V, typename Compare>
+V& SkipListMap<K, V, Compare>::valueAt(int index)
+{
+	return nodeAt(index + 1)->value;
+}
+
+// Getters
+
+template<typename K, typename V, typename Compare>
+inline int SkipListMap<K, V, Compare>::size()
+{
+	return size_;
+}
+
+template<typename K, typename V, typename Compare>
+inline bool SkipListMap<K, V, Compare>::isEmpty()
+{
+	return size_ == 0;
+}
+
+// PRIVATES
+
+template<typename K, typename V, typename Compare>
+inline size_t SkipListMap<K, V, Compare>::towerOffset()
+{
+	return (sizeof(Node) + alignof(Level) - 1) / alignof(Level) * alignof(Level);
+}
+
+template<typename K, typename V, typename Compare>
+typename SkipListMap<K, V, Compare>::Node* SkipListMap<K, V, Compare>::createNode(K key, V value, int levels)
+{
+	void* memory = ::operator new(towerOffset() + levels * sizeof(Level));
+
+	return new (memory) Node(key, value, levels);
+}
+
+template<typename K, typename V, typename Compare>
+void SkipListMap<K, V, Compare>::destroyNode(Node* node)
+{
+	node->~Node();
+	::operator delete(node);
+}
+
+template<typename K, typename V, typename Compare>
+int SkipListMap<K, V, Compare>::generateHeight()
+{
+	// every trailing zero of a random word is one more promotion (with probability 1/2)
+	int levels = 1 + FastRandom::trailingZeros(random_.next());
+
+	return levels < MAX_HEIGHT ? levels : MAX_HEIGHT;
+}
+
+template<typename K, typename V, typename Compare>
+inline bool SkipListMap<K, V, Compare>::same(const K& a, const K& b)
+{
+	return !compare_(a, b) && !compare_(b, a);
+}
+
+template<typename K, typename V, typename Compare>
+typename SkipListMap<K, V, Compare>::Node* SkipListMap<K, V, Compare>::findPath(const K& key, Level** path, int* ranks)
+{
+	Level* tower = head_;
+	int rank = 0;
+
+	for (int level = height_ - 1; 0 <= level; level--)
+	{
+		while (tower[level].next && compare_(tower[level].next->key, key))
+		{
+			rank += tower[level].dist;
+			tower = tower[level].next->tower();
+		}
+
+		path[level] = &tower[level];
+
+		if (ranks)
+		{
+			ranks[level] = rank;
+		}
+	}
+
+	return tower[0].next;
+}
+
+template<typename K, typename V, typename Compare>
+typename SkipListMap<K, V, Compare>::Node* SkipListMap<K, V, Compare>::nodeAt(int position)
+{
+	if (position < 1 || position > size_)
+	{
+		throw std::out_of_range("index out of range");
+	}
+
+	Level* tower = head_;
+	Node* node = nullptr;
+
+	for (int level = height_ - 1; 0 <= level; level--)
+	{
+		while (tower[level].dist <= position)
+		{
+			position -= tower[level].dist;
+			node = tower[level].next;
+			tower = node->tower();
+		}
+	}
+
+	return node;
+}
+
+template<typename K, typename V, typename Compare>
+typename SkipListMap<K, V, Compare>::Node* SkipListMap<K, V, Compare>::link(K key, V value, Level** path, int* ranks)
+{
+	int levels = generateHeight();
+
+	// the new levels start empty, the jump from the head to their end passes over all the nodes
+	for (; height_ < levels; height_++)
+	{
+		head_[height_].next = nullptr;
+		head_[height_].dist = size_ + 1;
+
+		path[height_] = &head_[height_];
+		ranks[height_] = 0;
+	}
+
+	Node* node = createNode(key, value, levels);
+	Level* tower = node->tower();
+	int newRank = ranks[0] + 1;
+
+	for (int level = 0; level < levels; level++)
+	{
+		tower[level].next = path[level]->next;
+		tower[level].dist = ranks[level] + path[level]->dist + 1 - newRank;
+
+		path[level]->next = node;
+		path[level]->dist = newRank - ranks[level];
+	}
+
+	// the jumps above the new node pass over one more node
+	for (int level = levels; level < height_; level++)
+	{
+		path[level]->dist++;
+	}
+
+	size_++;
+
+	return node;
+}
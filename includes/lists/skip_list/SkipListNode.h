@@ -1,17 +1,42 @@
 #pragma once
 
+#include <cstddef>
+#include <new>
 #include <stdexcept>
-#include "../DynamicArray.h"
 
+/**
+ * A node in a skip list, allocated as a single block.
+ * The node is followed in memory by its tower: a {next, dist} pair for each level,
+ * and optionally by a back (prev) pointer for each level.
+ * Nodes are made with create/createSentinel and released with destroy.
+ */
 template<typename T>
 class SkipListNode
 {
 public:
-	// Constructor
-
-	SkipListNode<T>();
-
-	SkipListNode<T>(T key);
+	// Factories
+
+	/**
+	 * @brief create a node with a key.
+	 * @param key
+	 * @param levels the number of levels in the node's tower (its height + 1).
+	 * @param hasPrev whether to keep back pointers.
+	*/
+	static SkipListNode<T>* create(T key, int levels, bool hasPrev);
+
+	/**
+	 * @brief create a node without a key (a head or a tail) and without levels,
+	 * that can grow up to a given number of levels.
+	 * @param capacity the maximal number of levels.
+	 * @param hasPrev whether to keep back pointers.
+	*/
+	static SkipListNode<T>* createSentinel(int capacity, bool hasPrev);
+
+	/**
+	 * @brief release a node made by create or createSentinel.
+	 * @param node
+	*/
+	static void destroy(SkipListNode<T>* node);
 
 	// Getters
 
@@ -27,6 +52,8 @@ public:
 
 	bool hasKey();
 
+	bool hasPrev();
+
 	// Setters
 
 	void setNext(int level, SkipListNode<T>* next);
@@ -40,82 +67,146 @@ public:
 	void removeHighestLevel();
 
 private:
-	DynamicArray<SkipListNode<T>*>* next_;
+	/** A level in the tower - the next node on this level and the number of level 0 steps to it. */
+	struct Level
+	{
+		SkipListNode<T>* next;
+		int dist;
+	};
 
-	DynamicArray<SkipListNode<T>*>* prev_;
+	int height_;
 
-	DynamicArray<int>* dist_;
+	int capacity_;
 
-	int height_;
+	bool hasKey_;
+
+	bool hasPrev_;
 
 	T key_;
 
-	bool hasKey_;
+	SkipListNode<T>(int height, int capacity, bool hasPrev);
+
+	static SkipListNode<T>* allocate(int height, int capacity, bool hasPrev);
+
+	/** the distance from the start of the node to its tower, aligned for the levels. */
+	static size_t towerOffset();
+
+	Level* tower();
+
+	SkipListNode<T>** prevs();
+
+	void checkLevel(int level);
 };
 
+// Factories
+
+template<typename T>
+SkipListNode<T>::SkipListNode(int height, int capacity, bool hasPrev)
+{
+	height_ = height;
+	capacity_ = capacity;
+	hasKey_ = false;
+	hasPrev_ = hasPrev;
+
+	for (int level = 0; level < capacity; level++)
+	{
+		tower()[level].next = nullptr;
+		tower()[level].dist = 1;
+
+		if (hasPrev)
+		{
+			prevs()[level] = nullptr;
+		}
+	}
+}
+
 template<typename T>
-SkipListNode<T>::SkipListNode()
+SkipListNode<T>* SkipListNode<T>::allocate(int height, int capacity, bool hasPrev)
 {
-	next_ = new DynamicArray<SkipListNode<T>*>(2);
+	if (capacity <= 0)
+	{
+		throw std::invalid_argument("a node should have at least one level");
+	}
 
-	prev_ = new DynamicArray<SkipListNode<T>*>(2);
+	// the node, then its tower, then its back pointers - all in one block
+	size_t bytes = towerOffset() + capacity * sizeof(Level);
 
-	dist_ = new DynamicArray<int>(2);
+	if (hasPrev)
+	{
+		bytes += capacity * sizeof(SkipListNode<T>*);
+	}
 
-	height_ = -1;
+	void* memory = ::operator new(bytes);
 
-	hasKey_ = false;
+	return new (memory) SkipListNode<T>(height, capacity, hasPrev);
+}
+
+template<typename T>
+SkipListNode<T>* SkipListNode<T>::create(T key, int levels, bool hasPrev)
+{
+	SkipListNode<T>* node = allocate(levels - 1, levels, hasPrev);
+
+	node->key_ = key;
+	node->hasKey_ = true;
+
+	return node;
 }
 
 template<typename T>
-SkipListNode<T>::SkipListNode(T key) : SkipListNode<T>()
+SkipListNode<T>* SkipListNode<T>::createSentinel(int capacity, bool hasPrev)
 {
-	key_ = key;
-	
-	hasKey_ = true;
+	return allocate(-1, capacity, hasPrev);
 }
 
 template<typename T>
-SkipListNode<T>* SkipListNode<T>::getNext(int level)
+void SkipListNode<T>::destroy(SkipListNode<T>* node)
 {
-	if (level > getHeight())
+	if (node)
 	{
-		throw std::out_of_range("level greater than node's height");
+		node->~SkipListNode<T>();
+		::operator delete(node);
 	}
+}
+
+// Getters
 
-	return next_->get(level);
+template<typename T>
+inline SkipListNode<T>* SkipListNode<T>::getNext(int level)
+{
+	checkLevel(level);
+
+	return tower()[level].next;
 }
 
 template<typename T>
-SkipListNode<T>* SkipListNode<T>::getPrev(int level)
+inline SkipListNode<T>* SkipListNode<T>::getPrev(int level)
 {
-	if (level > getHeight())
+	checkLevel(level);
+
+	if (!hasPrev_)
 	{
-		throw std::out_of_range("level greater than node's height");
+		throw std::logic_error("this node has no back pointers");
 	}
 
-	return prev_->get(level);
+	return prevs()[level];
 }
 
 template<typename T>
-int SkipListNode<T>::getDist(int level)
+inline int SkipListNode<T>::getDist(int level)
 {
-	if (level > getHeight())
-	{
-		throw std::out_of_range("level greater than node's height");
-	}
+	checkLevel(level);
 
-	return dist_->get(level);
+	return tower()[level].dist;
 }
 
 template<typename T>
-int SkipListNode<T>::getHeight()
+inline int SkipListNode<T>::getHeight()
 {
 	return height_;
 }
 
 template<typename T>
-T SkipListNode<T>::getKey()
+inline T SkipListNode<T>::getKey()
 {
 	if (!hasKey())
 	{
@@ -126,62 +217,102 @@ T SkipListNode<T>::getKey()
 }
 
 template<typename T>
-bool SkipListNode<T>::hasKey()
+inline bool SkipListNode<T>::hasKey()
 {
 	return hasKey_;
 }
 
 template<typename T>
-void SkipListNode<T>::setNext(int level, SkipListNode<T>* next)
+inline bool SkipListNode<T>::hasPrev()
 {
-	if (level > getHeight())
-	{
-		throw std::out_of_range("level greater than node's height");
-	}
-
-	next_->set(level, next);
+	return hasPrev_;
 }
 
+// Setters
+
 template<typename T>
-void SkipListNode<T>::setPrev(int level, SkipListNode<T>* prev)
+inline void SkipListNode<T>::setNext(int level, SkipListNode<T>* next)
 {
-	if (level > getHeight())
-	{
-		throw std::out_of_range("level greater than node's height");
-	}
+	checkLevel(level);
 
-	prev_->set(level, prev);
+	tower()[level].next = next;
 }
 
 template<typename T>
-void SkipListNode<T>::setDist(int level, int dist)
+inline void SkipListNode<T>::setPrev(int level, SkipListNode<T>* prev)
 {
-	if (level > getHeight())
+	checkLevel(level);
+
+	// a list without back pointers ignores them
+	if (hasPrev_)
 	{
-		throw std::out_of_range("level greater than node's height");
+		prevs()[level] = prev;
 	}
+}
+
+template<typename T>
+inline void SkipListNode<T>::setDist(int level, int dist)
+{
+	checkLevel(level);
 
-	dist_->set(level, dist);
+	tower()[level].dist = dist;
 }
 
 template<typename T>
 void SkipListNode<T>::addLevel(SkipListNode<T>* prev, SkipListNode<T>* next)
 {
-	height_++;
+	if (height_ + 1 >= capacity_)
+	{
+		throw std::overflow_error("this node reached its max. height");
+	}
 
-	next_->add(next);
+	height_++;
 
-	prev_->add(prev);
+	tower()[height_].next = next;
+	tower()[height_].dist = 1;
 
-	dist_->add(1);
+	if (hasPrev_)
+	{
+		prevs()[height_] = prev;
+	}
 }
 
 template<typename T>
 void SkipListNode<T>::removeHighestLevel()
 {
-	next_->removeLast();
-	prev_->removeLast();
-	dist_->removeLast();
+	if (height_ < 0)
+	{
+		throw std::underflow_error("this node has no levels");
+	}
 
 	height_--;
 }
+
+// PRIVATES
+
+template<typename T>
+inline size_t SkipListNode<T>::towerOffset()
+{
+	return (sizeof(SkipListNode<T>) + alignof(Level) - 1) / alignof(Level) * alignof(Level);
+}
+
+template<typename T>
+inline typename SkipListNode<T>::Level* SkipListNode<T>::tower()
+{
+	return reinterpret_cast<Level*>(reinterpret_cast<char*>(this) + towerOffset());
+}
+
+template<typename T>
+inline SkipListNode<T>** SkipListNode<T>::prevs()
+{
+	return reinterpret_cast<SkipListNode<T>**>(tower() + capacity_);
+}
+
+template<typename T>
+inline void SkipListNode<T>::checkLevel(int level)
+{
+	if (level > height_)
+	{
+		throw std::out_of_range("level greater than node's height");
+	}
+}
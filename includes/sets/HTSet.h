@@ -87,13 +87,11 @@ template<typename T>
 inline T* HTSet<T>::elementsArray()
 {
 	T* arr = new T[size()];
+	int i = 0;
 
-	DNode<T>* curr = list_->getNode(0);
-
-	for (int i = 0; i < size(); i++)
+	for (T element : *list_)
 	{
-		arr[i] = curr->data();
-		curr = curr->next;
+		arr[i++] = element;
 	}
 
 	return arr;
@@ -104,12 +102,10 @@ inline HTSet<T>* HTSet<T>::unionSet(Set<T>& other)
 {
 	HTSet<T>* set = new HTSet<T>;
 	T* otherElements = other.elementsArray();
-	DNode<T>* curr = list_->getNode(0);
 
-	for (int i = 0; i < size(); i++)
+	for (T element : *list_)
 	{
-		set->addNoSearch(curr->data());
-		curr = curr->next;
+		set->addNoSearch(element);
 	}
 
 	for (int i = 0; i < other.size(); i++)
@@ -127,20 +123,15 @@ inline HTSet<T>* HTSet<T>::intersectionSet(Set<T>& other)
 	HTSet<T>* set = new HTSet<T>;
 	bool thisIsShorter = size() <= other.size();
 	T* otherElements = other.elementsArray();
-	DNode<T>* curr;
 
 	if (thisIsShorter)
 	{
-		curr = list_->getNode(0);
-
-		for (int i = 0; i < size(); i++)
+		for (T element : *list_)
 		{
-			if (other.contains(curr->data()))
+			if (other.contains(element))
 			{
-				set->addNoSearch(curr->data());
+				set->addNoSearch(element);
 			}
-
-			curr = curr->next;
 		}
 	}
 	else
@@ -161,6 +152,6 @@ inline HTSet<T>* HTSet<T>::intersectionSet(Set<T>& other)
 template<typename T>
 inline void HTSet<T>::addNoSearch(T element)
 {
-	list_->addLast(element);
-	table_->insert(element, list_->getNode(0)->prev->prev);
+	typename DLinkedList<T>::Iterator node = list_->insertBefore(list_->end(), element);
+	table_->insert(element, node.node());
 }
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * Helpers shared by the benchmarks in this directory ("make bench-<name>" runs tests/<name>_bench.cpp).
+ * A benchmark prints the best time of a few runs of each case. The results of the measured work
+ * go to a sink, so the compiler cannot drop the work. The sizes are defaults, most programs take
+ * others on the command line.
+ */
+namespace bench
+{
+	/**
+	 * @brief stop the run if a result is wrong.
+	*/
+	inline void check(bool condition, const char* message)
+	{
+		if (!condition)
+		{
+			fprintf(stderr, "FAILED: %s\n", message);
+			exit(1);
+		}
+	}
+
+	/**
+	 * @brief keep a result of the measured work alive.
+	*/
+	inline void keep(long long value)
+	{
+		static volatile long long sink = 0;
+
+		sink = sink + value;
+	}
+
+	/**
+	 * @brief get a number from the command line, or a default one.
+	*/
+	inline long long argument(int argc, char** argv, int index, long long fallback)
+	{
+		return argc > index ? atoll(argv[index]) : fallback;
+	}
+
+	/**
+	 * @brief the best time in milliseconds of a few runs of a function.
+	 * @param setup called before every run, outside of the timing.
+	*/
+	template<typename Setup, typename F>
+	double best(int runs, Setup setup, F f)
+	{
+		double result = 0;
+
+		for (int r = 0; r < runs; r++)
+		{
+			setup();
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			f();
+
+			double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			if (r == 0 || time < result)
+			{
+				result = time;
+			}
+		}
+
+		return result;
+	}
+
+	template<typename F>
+	double best(int runs, F f)
+	{
+		return best(runs, []() {}, f);
+	}
+
+	/**
+	 * @brief print a line of a result table.
+	 * @param baseline the time of the case this one is compared with, 0 for none.
+	*/
+	inline void row(const char* name, double ms, double baseline = 0)
+	{
+		if (baseline > 0)
+		{
+			printf("  %-40s %10.2f ms  %7.2fx\n", name, ms, baseline / ms);
+		}
+		else
+		{
+			printf("  %-40s %10.2f ms\n", name, ms);
+		}
+	}
+}
@@ -0,0 +1,177 @@
+/**
+ * ConcurrentSkipList: throughput with 1, 2, 4, ... threads, against a SkipList behind a mutex.
+ * The map starts with half of the keys below 2n, and the threads split a fixed number of random
+ * operations between them (strong scaling), in a read-mostly mix (90% find) and an update-heavy
+ * mix (50% find, 25% insert, 25% remove). The speedup is over one thread of the same map.
+ * Speedups only mean something on a machine with several cores; with one hardware thread the
+ * threads just take turns, and the rows show the cost of the sharing.
+ * Usage: ./concurrent_skip_list_bench [keys] [operations] [maximum threads]
+ */
+
+#include "bench.h"
+#include "lists/skip_list/ConcurrentSkipList.h"
+#include "lists/skip_list/SkipList.h"
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief the lock-free map.
+	 */
+	struct LockFree
+	{
+		ConcurrentSkipList<int, int> map;
+
+		bool find(int key)
+		{
+			return map.contains(key);
+		}
+
+		bool insert(int key)
+		{
+			return map.insert(key, key);
+		}
+
+		bool remove(int key)
+		{
+			return map.remove(key);
+		}
+	};
+
+	/**
+	 * @brief the single-threaded list, one call at a time.
+	 */
+	struct Locked
+	{
+		SkipList<int> list;
+		std::mutex lock;
+
+		bool find(int key)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			return list.find(key) != nullptr;
+		}
+
+		bool insert(int key)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			return list.insert(key) != nullptr;
+		}
+
+		bool remove(int key)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			return list.remove(key);
+		}
+	};
+
+	/**
+	 * @brief fill a map and run the operations on it from a number of threads.
+	 * @param finds the percentage of finds, the rest are inserts and removes in equal parts.
+	 * @return the time in milliseconds.
+	 */
+	template<typename M>
+	double run(int keys, int operations, int threads, int finds)
+	{
+		M map;
+
+		for (int key = 0; key < 2 * keys; key += 2)
+		{
+			map.insert(key);
+		}
+
+		std::vector<std::thread> workers;
+		std::vector<long long> hits(threads);
+
+		return bench::best(1, [&]()
+		{
+			for (int t = 0; t < threads; t++)
+			{
+				workers.push_back(std::thread([&, t]()
+				{
+					std::mt19937 random(t + 1);
+					long long count = 0;
+
+					for (int i = t; i < operations; i += threads)
+					{
+						int key = (int)(random() % (2 * keys));
+						int kind = (int)(random() % 100);
+
+						if (kind < finds)
+						{
+							count += map.find(key);
+						}
+						else if (kind % 2 == 0)
+						{
+							count += map.insert(key);
+						}
+						else
+						{
+							count += map.remove(key);
+						}
+					}
+
+					hits[t] = count;
+				}));
+			}
+
+			for (std::thread& worker : workers)
+			{
+				worker.join();
+			}
+
+			for (long long count : hits)
+			{
+				bench::keep(count);
+			}
+		});
+	}
+
+	template<typename M>
+	void scale(const char* name, int keys, int operations, int maximum, int finds)
+	{
+		double single = 0;
+
+		printf("  %s\n", name);
+
+		for (int threads = 1; threads <= maximum; threads *= 2)
+		{
+			double ms = run<M>(keys, operations, threads, finds);
+
+			if (threads == 1)
+			{
+				single = ms;
+			}
+
+			printf("    %2d threads %10.2f ms %8.2f Mops/s  %6.2fx\n", threads, ms, operations / ms / 1000, single / ms);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int hardware = (int)std::thread::hardware_concurrency();
+
+	int keys = (int)bench::argument(argc, argv, 1, 100000);
+	int operations = (int)bench::argument(argc, argv, 2, 1000000);
+	int maximum = (int)bench::argument(argc, argv, 3, std::max(hardware, 4));
+
+	printf("%d keys, %d operations, %d hardware threads\n", keys, operations, hardware);
+
+	printf("\nread-mostly (90%% find)\n");
+	scale<LockFree>("ConcurrentSkipList", keys, operations, maximum, 90);
+	scale<Locked>("SkipList + mutex", keys, operations, maximum, 90);
+
+	printf("\nupdate-heavy (50%% find)\n");
+	scale<LockFree>("ConcurrentSkipList", keys, operations, maximum, 50);
+	scale<Locked>("SkipList + mutex", keys, operations, maximum, 50);
+
+	return 0;
+}
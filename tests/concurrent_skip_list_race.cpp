@@ -0,0 +1,159 @@
+/**
+ * A regression test for a race between a remove and an insert of the same key in ConcurrentSkipList.
+ * The remover marks its node V, and the inserter, which saw V unmarked in level 1 and marked in
+ * level 0, snips V out of level 0 and links its own node N in front of V in level 1. The cleanup
+ * of the remover has to snip V from behind N before V is retired, or a later search that walks
+ * past N in level 1 reads a deleted node.
+ * The steps of the two threads are ordered through the CONCURRENT_SKIP_LIST_STEP hook. The
+ * heights of the nodes are random, so the scenario is run until N was linked in level 1 enough
+ * times.
+ * Build and run with "make race" (AddressSanitizer reports the read of the deleted node).
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+	enum Role { OTHER, INSERTER, REMOVER };
+
+	thread_local Role role = OTHER;
+
+	// the steps of the scenario, in order
+	std::atomic<bool> inserterAtLevel0(false);
+	std::atomic<bool> removerMarked(false);
+	std::atomic<bool> inserterDone(false);
+
+	// the upper level a node was linked in last, by any thread
+	std::atomic<int> linkedLevel(-1);
+
+	void waitFor(std::atomic<bool>& step)
+	{
+		while (!step.load())
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	void step(const char* point, int level)
+	{
+		if (strcmp(point, "insertLinked") == 0 && level > 0)
+		{
+			linkedLevel.store(level);
+		}
+
+		// the inserter has read level 1 and stops before level 0, until the remover marked V
+		if (role == INSERTER && strcmp(point, "findLevel") == 0 && level == 0 && !inserterAtLevel0.load())
+		{
+			inserterAtLevel0.store(true);
+			waitFor(removerMarked);
+		}
+
+		// the remover stops before its cleanup, until the inserter linked N
+		if (role == REMOVER && strcmp(point, "removeMarked") == 0)
+		{
+			removerMarked.store(true);
+			waitFor(inserterDone);
+		}
+	}
+}
+
+#define CONCURRENT_SKIP_LIST_STEP(point, level) step(#point, level)
+
+#include "lists/skip_list/ConcurrentSkipList.h"
+
+namespace
+{
+	const int KEY = 7;
+	const int RUNS = 20;            // the runs where N was linked in level 1
+	const int MAX_ATTEMPTS = 1000;
+
+	void check(bool condition, const char* message)
+	{
+		if (!condition)
+		{
+			fprintf(stderr, "FAILED: %s\n", message);
+			exit(1);
+		}
+	}
+
+	/**
+	 * @brief run the scenario once.
+	 * @return true iff N was linked in level 1.
+	 */
+	bool run()
+	{
+		ConcurrentSkipList<int, int> map(2);
+
+		map.insert(KEY + 1, 0);
+
+		// V has to be in level 1
+		linkedLevel.store(-1);
+
+		while (!map.insert(KEY, 1) || linkedLevel.load() != 1)
+		{
+			map.remove(KEY);
+			linkedLevel.store(-1);
+		}
+
+		inserterAtLevel0.store(false);
+		removerMarked.store(false);
+		inserterDone.store(false);
+		linkedLevel.store(-1);
+
+		bool inserted = false, removed = false;
+
+		std::thread inserter([&]()
+		{
+			role = INSERTER;
+			inserted = map.insert(KEY, 2);
+			inserterDone.store(true);
+		});
+
+		std::thread remover([&]()
+		{
+			role = REMOVER;
+			waitFor(inserterAtLevel0);
+			removed = map.remove(KEY);
+		});
+
+		inserter.join();
+		remover.join();
+
+		bool linked = linkedLevel.load() == 1;
+
+		// V is retired now, let the epochs move on until it is deleted
+		for (int i = 0; i < 4; i++)
+		{
+			EpochReclaimer::instance().collect();
+		}
+
+		int value = 0;
+
+		check(inserted && removed, "the insert and the remove should both succeed");
+		check(map.find(KEY, value) && value == 2, "the inserted key is missing");
+		check(!map.contains(KEY + 2), "a key that was never inserted is found");
+		check(map.size() == 2, "the size is wrong");
+
+		return linked;
+	}
+}
+
+int main()
+{
+	int runs = 0;
+
+	for (int attempt = 0; attempt < MAX_ATTEMPTS && runs < RUNS; attempt++)
+	{
+		runs += run() ? 1 : 0;
+	}
+
+	check(runs == RUNS, "the node of the inserter was never linked in level 1");
+
+	printf("ok: the race ran %d times\n", runs);
+
+	return 0;
+}
@@ -0,0 +1,255 @@
+/**
+ * A linearizability stress test for ConcurrentSkipList.
+ * Threads run random insert / remove / find calls on a few keys in rounds, recording for each call
+ * the times it started and returned (from one atomic clock) and its result. Linearizability is
+ * local, so each key's history is checked on its own: a search looks for an order of the calls
+ * that respects real time and the sequential behavior of a set (Wing & Gong).
+ * Between the rounds the map is checked against the linearized state of every key, and during
+ * the rounds rangeScan is checked to be sorted, inside its bounds, and to see the keys that no
+ * thread touches.
+ * Build and run with "make stress" (ThreadSanitizer) or "make stress-asan" (AddressSanitizer,
+ * which also catches nodes reclaimed too early).
+ */
+
+#include "lists/skip_list/ConcurrentSkipList.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	const int THREADS = 4;
+	const int ROUNDS = 400;
+	const int OPS_PER_ROUND = 40;      // per thread
+	const int KEYS = 8;                // the keys the threads update in a round
+	const int STABLE_KEYS = 16;        // keys that stay in the map, every scan must see them
+	const int STABLE_BASE = 1000;
+
+	enum Kind { INSERT, REMOVE, FIND };
+
+	/** A call and its result, with the clock before it started and after it returned. */
+	struct Call
+	{
+		Kind kind;
+		bool result;
+		long long invoked;
+		long long returned;
+	};
+
+	std::atomic<long long> clock_(0);
+
+	void check(bool condition, const char* message)
+	{
+		if (!condition)
+		{
+			fprintf(stderr, "FAILED: %s\n", message);
+			exit(1);
+		}
+	}
+
+	int valueOf(int key)
+	{
+		return key * 2 + 1;
+	}
+
+	/**
+	 * Apply a call to the state of a key (present or not).
+	 * @return false iff the call's result is impossible in that state.
+	 */
+	bool apply(const Call& call, bool& present)
+	{
+		switch (call.kind)
+		{
+		case INSERT:
+			if (call.result == present)
+			{
+				return false;
+			}
+
+			present = true;
+			return true;
+		case REMOVE:
+			if (call.result != present)
+			{
+				return false;
+			}
+
+			present = false;
+			return true;
+		default:
+			return call.result == present;
+		}
+	}
+
+	/**
+	 * Search for a linearization of the calls not in done, from a state to a final state.
+	 * A call can go next if it started before every other pending call returned.
+	 * @param failed the (done, state) pairs already known to have no linearization.
+	 */
+	bool linearize(const std::vector<Call>& calls, unsigned long long done, bool present, bool final,
+		std::unordered_set<unsigned long long>& failed)
+	{
+		int n = (int)calls.size();
+
+		if (done == (1ULL << n) - 1)
+		{
+			return present == final;
+		}
+
+		// the state is part of the memo key, in the bit the calls cannot use
+		unsigned long long memo = done ^ (present ? 1ULL << 63 : 0);
+
+		if (failed.count(memo))
+		{
+			return false;
+		}
+
+		long long firstReturn = -1;
+
+		for (int i = 0; i < n; i++)
+		{
+			if (!(done >> i & 1) && (firstReturn < 0 || calls[i].returned < firstReturn))
+			{
+				firstReturn = calls[i].returned;
+			}
+		}
+
+		for (int i = 0; i < n; i++)
+		{
+			if (done >> i & 1 || calls[i].invoked > firstReturn)
+			{
+				continue;
+			}
+
+			bool next = present;
+
+			if (apply(calls[i], next) && linearize(calls, done | 1ULL << i, next, final, failed))
+			{
+				return true;
+			}
+		}
+
+		failed.insert(memo);
+
+		return false;
+	}
+}
+
+int main()
+{
+	ConcurrentSkipList<int, int> map;
+
+	for (int i = 0; i < STABLE_KEYS; i++)
+	{
+		map.insert(STABLE_BASE + i, valueOf(STABLE_BASE + i));
+	}
+
+	bool present[KEYS] = { false };
+	long long checkedCalls = 0;
+
+	for (int round = 0; round < ROUNDS; round++)
+	{
+		std::vector<std::vector<Call> > histories(THREADS * KEYS);
+		std::vector<std::thread> threads;
+
+		for (int t = 0; t < THREADS; t++)
+		{
+			threads.push_back(std::thread([&, t]()
+			{
+				std::mt19937 random(round * THREADS + t);
+
+				for (int i = 0; i < OPS_PER_ROUND; i++)
+				{
+					int key = (int)(random() % KEYS);
+					Call call;
+
+					call.kind = (Kind)(random() % 3);
+					call.invoked = clock_.fetch_add(1);
+
+					if (call.kind == INSERT)
+					{
+						call.result = map.insert(key, valueOf(key));
+					}
+					else if (call.kind == REMOVE)
+					{
+						call.result = map.remove(key);
+					}
+					else
+					{
+						int value = 0;
+
+						call.result = map.find(key, value);
+						check(!call.result || value == valueOf(key), "find returned a wrong value");
+					}
+
+					call.returned = clock_.fetch_add(1);
+					histories[t * KEYS + key].push_back(call);
+
+					// a scan over the updated keys and the stable ones
+					if (i % 8 == 0)
+					{
+						int previous = -1, stable = 0;
+
+						map.rangeScan(0, STABLE_BASE + STABLE_KEYS, [&](int k, int v)
+						{
+							check(k > previous, "rangeScan is not in increasing order");
+							check(k >= 0 && k <= STABLE_BASE + STABLE_KEYS, "rangeScan left its range");
+							check(v == valueOf(k), "rangeScan returned a wrong value");
+
+							previous = k;
+							stable += k >= STABLE_BASE ? 1 : 0;
+						});
+
+						check(stable == STABLE_KEYS, "rangeScan missed a key that stayed in the map");
+					}
+				}
+			}));
+		}
+
+		for (int t = 0; t < THREADS; t++)
+		{
+			threads[t].join();
+		}
+
+		// check every key's history, starting from the state the last round left
+		for (int key = 0; key < KEYS; key++)
+		{
+			std::vector<Call> calls;
+
+			for (int t = 0; t < THREADS; t++)
+			{
+				calls.insert(calls.end(), histories[t * KEYS + key].begin(), histories[t * KEYS + key].end());
+			}
+
+			check(calls.size() < 63, "too many calls on a key to check");
+
+			// the map is quiescent, so the history has to end in the state it shows now
+			bool now = map.contains(key);
+			std::unordered_set<unsigned long long> failed;
+
+			check(linearize(calls, 0, present[key], now, failed), "a key's history is not linearizable");
+
+			present[key] = now;
+			checkedCalls += (long long)calls.size();
+		}
+
+		int expected = STABLE_KEYS;
+
+		for (int key = 0; key < KEYS; key++)
+		{
+			expected += present[key] ? 1 : 0;
+		}
+
+		check(map.size() == expected, "size does not match the keys in the map");
+		check(map.rangeScan(0, STABLE_BASE + STABLE_KEYS, [](int, int) {}) == expected,
+			"a quiescent rangeScan does not see every key");
+	}
+
+	printf("ok: %lld calls in %d rounds are linearizable\n", checkedCalls, ROUNDS);
+
+	return 0;
+}
@@ -0,0 +1,176 @@
+/**
+ * DaryHeap: push and pop throughput for D = 2, 4 and 8, against MinHeap and MaxHeap, and against
+ * the binary heap MinHeap was before DaryHeap (RecursiveHeap: swaps on the way up, and a
+ * recursive heapify with swaps on the way down).
+ * Each case pushes n random keys and pops them all, a few times for the small sizes, and checks
+ * that they come out in order. The sizes grow by 100 from 1K up to a maximum.
+ * Usage: ./dary_heap_bench [maximum size]
+ */
+
+#include "bench.h"
+#include "heaps/DaryHeap.h"
+#include "heaps/MaxHeap.h"
+#include "heaps/MinHeap.h"
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace
+{
+	const long long WORK = 4000000;     // the pushes of a case, over all its rounds
+
+	/**
+	 * @brief the binary min. heap with swapping sifts that MinHeap used to be.
+	 */
+	class RecursiveHeap
+	{
+	public:
+		explicit RecursiveHeap(int capacity) : arr_(capacity), size_(0) {}
+
+		void insert(int key)
+		{
+			int i = size_++;
+
+			arr_[i] = key;
+
+			while (i && arr_[(i - 1) / 2] > arr_[i])
+			{
+				int tmp = arr_[(i - 1) / 2];
+
+				arr_[(i - 1) / 2] = arr_[i];
+				arr_[i] = tmp;
+
+				i = (i - 1) / 2;
+			}
+		}
+
+		int extractMin()
+		{
+			int min = arr_[0];
+
+			arr_[0] = arr_[--size_];
+
+			if (size_)
+			{
+				heapify(0);
+			}
+
+			return min;
+		}
+
+	private:
+		std::vector<int> arr_;
+		int size_;
+
+		void heapify(int i)
+		{
+			int left = 2 * i + 1, right = 2 * i + 2, smallest = i;
+
+			if (left < size_ && arr_[left] < arr_[smallest])
+			{
+				smallest = left;
+			}
+
+			if (right < size_ && arr_[right] < arr_[smallest])
+			{
+				smallest = right;
+			}
+
+			if (smallest != i)
+			{
+				int tmp = arr_[smallest];
+
+				arr_[smallest] = arr_[i];
+				arr_[i] = tmp;
+
+				heapify(smallest);
+			}
+		}
+	};
+
+	/**
+	 * @brief time pushing all the keys and popping them, and check the order they come out in.
+	 * @param pop pops the top of the heap.
+	 * @param ascending whether the keys come out in increasing order.
+	 */
+	template<typename H, typename Push, typename Pop>
+	void measure(const char* name, const std::vector<int>& keys, bool ascending, Push push, Pop pop)
+	{
+		int size = (int)keys.size();
+		int rounds = (int)(WORK / size > 0 ? WORK / size : 1);
+		double pushes = 0, pops = 0;
+		bool sorted = true;
+
+		for (int r = 0; r < rounds; r++)
+		{
+			H heap(size);
+
+			pushes += bench::best(1, [&]()
+			{
+				for (int key : keys)
+				{
+					push(heap, key);
+				}
+			});
+
+			int last = ascending ? -1 : 1 << 30;
+
+			pops += bench::best(1, [&]()
+			{
+				for (int i = 0; i < size; i++)
+				{
+					int key = pop(heap);
+
+					sorted = sorted && (ascending ? last <= key : key <= last);
+					last = key;
+				}
+			});
+		}
+
+		bench::check(sorted, name);
+
+		long long operations = (long long)rounds * size;
+
+		printf("  %-26s push %7.1f ns   pop %7.1f ns\n", name, 1000000 * pushes / operations, 1000000 * pops / operations);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	long long maximum = bench::argument(argc, argv, 1, 10000000);
+
+	for (long long size = 1000; size <= maximum; size *= 100)
+	{
+		std::vector<int> keys(size);
+		std::mt19937 random((int)size);
+
+		for (int& key : keys)
+		{
+			key = (int)(random() % (1 << 30));
+		}
+
+		printf("\n%lld keys (times per element)\n", size);
+
+		auto insert = [](RecursiveHeap& heap, int key) { heap.insert(key); };
+
+		measure<RecursiveHeap>("old recursive binary heap", keys, true, insert,
+				[](RecursiveHeap& heap) { return heap.extractMin(); });
+
+		measure<MinHeap<int> >("MinHeap", keys, true, [](MinHeap<int>& heap, int key) { heap.insert(key); },
+				[](MinHeap<int>& heap) { return heap.extractMin(); });
+
+		measure<MaxHeap<int> >("MaxHeap", keys, false, [](MaxHeap<int>& heap, int key) { heap.insert(key); },
+				[](MaxHeap<int>& heap) { return heap.extractMax(); });
+
+		measure<DaryHeap<int, 2> >("DaryHeap<int, 2>", keys, true, [](DaryHeap<int, 2>& heap, int key) { heap.insert(key); },
+				[](DaryHeap<int, 2>& heap) { return heap.extractTop(); });
+
+		measure<DaryHeap<int, 4> >("DaryHeap<int, 4>", keys, true, [](DaryHeap<int, 4>& heap, int key) { heap.insert(key); },
+				[](DaryHeap<int, 4>& heap) { return heap.extractTop(); });
+
+		measure<DaryHeap<int, 8> >("DaryHeap<int, 8>", keys, true, [](DaryHeap<int, 8>& heap, int key) { heap.insert(key); },
+				[](DaryHeap<int, 8>& heap) { return heap.extractTop(); });
+	}
+
+	return 0;
+}
@@ -0,0 +1,192 @@
+/**
+ * IndexedMinHeap: Dijkstra's shortest paths on a large random graph.
+ * With an indexed heap every vertex is in the heap at most once and an improved distance is a
+ * decreaseKey by the vertex's handle. The heaps without handles (MinHeap, DaryHeap) insert the
+ * vertex again with the new distance and skip the stale entries when they come out (lazy
+ * deletion), so they hold up to one entry per edge. The entries pack (distance, vertex) in one
+ * 64 bit key. All the runs must give the same distances.
+ * Usage: ./dijkstra_bench [vertices] [average out degree]
+ */
+
+#include "bench.h"
+#include "heaps/DaryHeap.h"
+#include "heaps/IndexedMinHeap.h"
+#include "heaps/MinHeap.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+	const long long UNREACHED = -1;
+
+	/**
+	 * @brief a directed graph in compressed rows: the edges of v are first[v] to first[v + 1] - 1.
+	 */
+	struct Graph
+	{
+		std::vector<int> first;
+		std::vector<int> target;
+		std::vector<int> weight;
+	};
+
+	Graph randomGraph(int vertices, int degree)
+	{
+		Graph graph;
+		std::mt19937 random(vertices);
+
+		graph.first.resize(vertices + 1);
+
+		for (int v = 0; v < vertices; v++)
+		{
+			graph.first[v] = (int)graph.target.size();
+
+			// a path through all the vertices keeps the graph connected
+			graph.target.push_back((v + 1) % vertices);
+			graph.weight.push_back(1 + (int)(random() % 1000));
+
+			for (int e = 1; e < degree; e++)
+			{
+				graph.target.push_back((int)(random() % vertices));
+				graph.weight.push_back(1 + (int)(random() % 1000));
+			}
+		}
+
+		graph.first[vertices] = (int)graph.target.size();
+
+		return graph;
+	}
+
+	std::vector<long long> indexed(const Graph& graph, int source, long long& operations)
+	{
+		int vertices = (int)graph.first.size() - 1;
+		std::vector<long long> dist(vertices, UNREACHED);
+		std::vector<int> handleOf(vertices, -1), vertexOf(vertices);
+		std::vector<bool> done(vertices, false);
+
+		IndexedMinHeap<long long> heap(vertices);
+
+		dist[source] = 0;
+		handleOf[source] = heap.insert(0);
+		vertexOf[handleOf[source]] = source;
+
+		while (!heap.isEmpty())
+		{
+			int handle;
+			long long d = heap.extractMin(handle);
+			int v = vertexOf[handle];
+
+			done[v] = true;
+
+			for (int e = graph.first[v]; e < graph.first[v + 1]; e++)
+			{
+				int u = graph.target[e];
+				long long next = d + graph.weight[e];
+
+				if (done[u] || (dist[u] != UNREACHED && dist[u] <= next))
+				{
+					continue;
+				}
+
+				if (dist[u] == UNREACHED)
+				{
+					handleOf[u] = heap.insert(next);
+					vertexOf[handleOf[u]] = u;
+				}
+				else
+				{
+					heap.decreaseKey(handleOf[u], next);
+				}
+
+				dist[u] = next;
+				operations++;
+			}
+		}
+
+		return dist;
+	}
+
+	/**
+	 * @brief Dijkstra with lazy deletion on a heap of packed (distance, vertex) keys.
+	 */
+	template<typename H, typename Push, typename Pop>
+	std::vector<long long> lazy(const Graph& graph, int source, long long& operations, Push push, Pop pop)
+	{
+		int vertices = (int)graph.first.size() - 1;
+		std::vector<long long> dist(vertices, UNREACHED);
+		std::vector<bool> done(vertices, false);
+
+		H heap(vertices);
+
+		dist[source] = 0;
+		push(heap, (long long)source);
+
+		while (!heap.isEmpty())
+		{
+			long long entry = pop(heap);
+			long long d = entry >> 32;
+			int v = (int)(entry & 0xffffffff);
+
+			if (done[v])
+			{
+				continue;
+			}
+
+			done[v] = true;
+
+			for (int e = graph.first[v]; e < graph.first[v + 1]; e++)
+			{
+				int u = graph.target[e];
+				long long next = d + graph.weight[e];
+
+				if (done[u] || (dist[u] != UNREACHED && dist[u] <= next))
+				{
+					continue;
+				}
+
+				dist[u] = next;
+				push(heap, next << 32 | u);
+				operations++;
+			}
+		}
+
+		return dist;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int vertices = (int)bench::argument(argc, argv, 1, 1000000);
+	int degree = (int)bench::argument(argc, argv, 2, 8);
+
+	Graph graph = randomGraph(vertices, degree);
+	std::vector<long long> expected, dist;
+	long long updates = 0;
+
+	printf("%d vertices, %d edges (times for one source)\n", vertices, (int)graph.target.size());
+
+	double ms = bench::best(3, [&]() { updates = 0; }, [&]() { expected = indexed(graph, 0, updates); });
+
+	printf("  %-38s %10.2f ms  (%lld inserts + decreaseKeys)\n", "IndexedMinHeap + decreaseKey", ms, updates);
+
+	ms = bench::best(3, [&]() { updates = 0; }, [&]()
+	{
+		dist = lazy<MinHeap<long long> >(graph, 0, updates,
+				[](MinHeap<long long>& heap, long long key) { heap.insert(key); },
+				[](MinHeap<long long>& heap) { return heap.extractMin(); });
+	});
+
+	bench::check(dist == expected, "MinHeap gives other distances");
+	printf("  %-38s %10.2f ms  (%lld inserts)\n", "MinHeap, lazy deletion", ms, updates);
+
+	ms = bench::best(3, [&]() { updates = 0; }, [&]()
+	{
+		dist = lazy<DaryHeap<long long, 4> >(graph, 0, updates,
+				[](DaryHeap<long long, 4>& heap, long long key) { heap.insert(key); },
+				[](DaryHeap<long long, 4>& heap) { return heap.extractTop(); });
+	});
+
+	bench::check(dist == expected, "DaryHeap gives other distances");
+	printf("  %-38s %10.2f ms  (%lld inserts)\n", "DaryHeap<4>, lazy deletion", ms, updates);
+
+	return 0;
+}
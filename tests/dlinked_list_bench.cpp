@@ -0,0 +1,129 @@
+/**
+ * DLinkedList: index loops against cursor loops.
+ * An index loop walks from an end of the list for every get or add, so a pass is O(n^2); a
+ * cursor pass is O(n). The last case moves half of a list into another one, element by element
+ * and with one splice.
+ * Usage: ./dlinked_list_bench [size]
+ */
+
+#include "bench.h"
+#include "lists/linked_lists/DLinkedList.h"
+
+namespace
+{
+	const int RUNS = 3;
+
+	void fill(DLinkedList<int>& list, int size)
+	{
+		while (!list.isEmpty())
+		{
+			list.removeLast();
+		}
+
+		for (int i = 0; i < size; i++)
+		{
+			list.addLast(i);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int size = (int)bench::argument(argc, argv, 1, 20000);
+	DLinkedList<int> list;
+
+	printf("DLinkedList, %d elements (times in ms, the speedup is over the index loop)\n", size);
+
+	fill(list, size);
+
+	long long expected = (long long)size * (size - 1) / 2;
+
+	double index = bench::best(RUNS, [&]()
+	{
+		long long sum = 0;
+
+		for (int i = 0; i < list.size(); i++)
+		{
+			sum += list.get(i);
+		}
+
+		bench::check(sum == expected, "wrong sum");
+		bench::keep(sum);
+	});
+
+	double cursor = bench::best(RUNS, [&]()
+	{
+		long long sum = 0;
+
+		for (int item : list)
+		{
+			sum += item;
+		}
+
+		bench::check(sum == expected, "wrong sum");
+		bench::keep(sum);
+	});
+
+	printf("\nsum all the elements\n");
+	bench::row("index loop (get(i))", index);
+	bench::row("cursor loop (range for)", cursor, index);
+
+	// insert an element after every element: by index, and before a cursor
+	index = bench::best(RUNS, [&]() { fill(list, size); }, [&]()
+	{
+		for (int i = 1; i <= 2 * size; i += 2)
+		{
+			list.add(-1, i);
+		}
+	});
+
+	bench::check(list.size() == 2 * size, "wrong size");
+
+	cursor = bench::best(RUNS, [&]() { fill(list, size); }, [&]()
+	{
+		for (DLinkedList<int>::Iterator it = list.begin(); it != list.end(); ++it)
+		{
+			list.insertBefore(++it, -1);
+			--it;
+		}
+	});
+
+	bench::check(list.size() == 2 * size, "wrong size");
+
+	printf("\ninsert an element after every element\n");
+	bench::row("index loop (add(item, i))", index);
+	bench::row("cursor loop (insertBefore)", cursor, index);
+
+	// move the second half of a list to the front of another one
+	DLinkedList<int> other;
+
+	index = bench::best(RUNS, [&]() { fill(list, size); fill(other, 0); }, [&]()
+	{
+		for (int i = 0; i < size - size / 2; i++)
+		{
+			other.add(list.removeLast(), 0);
+		}
+	});
+
+	bench::check(other.size() == size - size / 2 && other.get(0) == size / 2, "wrong move");
+
+	cursor = bench::best(RUNS, [&]() { fill(list, size); fill(other, 0); }, [&]()
+	{
+		DLinkedList<int>::Iterator middle = list.begin();
+
+		for (int i = 0; i < size / 2; i++)
+		{
+			++middle;
+		}
+
+		other.splice(other.begin(), list, middle, list.end(), size - size / 2);
+	});
+
+	bench::check(other.size() == size - size / 2 && other.get(0) == size / 2, "wrong splice");
+
+	printf("\nmove half of the list to another list\n");
+	bench::row("element by element", index);
+	bench::row("splice (walk to the middle + O(1) move)", cursor, index);
+
+	return 0;
+}
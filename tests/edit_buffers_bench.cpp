@@ -0,0 +1,148 @@
+/**
+ * GapBuffer and PieceTable: cursor-local edits on a large sequence, against DynamicArray.
+ * A cursor walks around the middle of the sequence in small random steps, and at each step
+ * an item is inserted at it or the item before it is removed (2 inserts for 1 removal).
+ * DynamicArray shifts the whole tail on every edit, so it runs fewer edits; the table shows
+ * the time per edit.
+ * Usage: ./edit_buffers_bench [size] [edits]
+ */
+
+#include "bench.h"
+#include "lists/DynamicArray.h"
+#include "lists/GapBuffer.h"
+#include "lists/PieceTable.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+	const int STEP = 8;         // the cursor moves by up to STEP positions between edits
+
+	struct Edit
+	{
+		int position;
+		bool insert;
+	};
+
+	/**
+	 * @brief a cursor-local edit script around the middle of a sequence.
+	 */
+	std::vector<Edit> script(int size, int edits)
+	{
+		std::mt19937 random(7);
+		std::vector<Edit> result(edits);
+		int cursor = size / 2;
+
+		for (int i = 0; i < edits; i++)
+		{
+			cursor += (int)(random() % (2 * STEP + 1)) - STEP;
+			cursor = cursor < 1 ? 1 : (cursor > size ? size : cursor);
+
+			result[i].position = cursor;
+			result[i].insert = random() % 3 != 0;
+			size += result[i].insert ? 1 : -1;
+		}
+
+		return result;
+	}
+
+	template<typename L>
+	void run(L& list, const std::vector<Edit>& edits, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (edits[i].insert)
+			{
+				list.add(i, edits[i].position);
+			}
+			else
+			{
+				list.removeAt(edits[i].position - 1);
+			}
+		}
+	}
+
+	/**
+	 * @brief the same edits through the cursor of a gap buffer.
+	 */
+	void runAtCursor(GapBuffer<int>& buffer, const std::vector<Edit>& edits, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			buffer.moveCursor(edits[i].position);
+
+			if (edits[i].insert)
+			{
+				buffer.insert(i);
+			}
+			else
+			{
+				buffer.erase();
+			}
+		}
+	}
+
+	void row(const char* name, double ms, int edits)
+	{
+		printf("  %-38s %8d edits %10.2f ms %10.3f us/edit\n", name, edits, ms, 1000 * ms / edits);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int size = (int)bench::argument(argc, argv, 1, 10000000);
+	int edits = (int)bench::argument(argc, argv, 2, 200000);
+	int arrayEdits = edits / 200 > 0 ? edits / 200 : 1;
+
+	std::vector<int> base(size);
+
+	for (int i = 0; i < size; i++)
+	{
+		base[i] = i;
+	}
+
+	std::vector<Edit> steps = script(size, edits);
+
+	printf("cursor-local edits on %d items\n", size);
+
+	// every structure runs the same edits, and ends with the same item at a probe position
+	int probe = steps[arrayEdits - 1].position - 1, expected;
+
+	{
+		DynamicArray<int> arr(base.data(), size);
+
+		double ms = bench::best(1, [&]() { run(arr, steps, arrayEdits); });
+
+		expected = arr.get(probe);
+		row("DynamicArray (add / removeAt)", ms, arrayEdits);
+	}
+
+	{
+		GapBuffer<int> buffer(base.data(), size);
+		GapBuffer<int> check(base.data(), size);
+
+		runAtCursor(check, steps, arrayEdits);
+		bench::check(check.get(probe) == expected, "GapBuffer edits differ from DynamicArray");
+
+		double ms = bench::best(1, [&]() { runAtCursor(buffer, steps, edits); });
+
+		bench::keep(buffer.get(size / 2));
+		row("GapBuffer (moveCursor + insert/erase)", ms, edits);
+	}
+
+	{
+		PieceTable<int> table(base.data(), size);
+		PieceTable<int> check(base.data(), size);
+
+		run(check, steps, arrayEdits);
+		bench::check(check.get(probe) == expected, "PieceTable edits differ from DynamicArray");
+
+		double ms = bench::best(1, [&]() { run(table, steps, edits); });
+
+		bench::keep(table.get(size / 2));
+		row("PieceTable (add / removeAt)", ms, edits);
+		printf("  (the table ends with %d pieces)\n", table.pieces());
+	}
+
+	return 0;
+}
@@ -0,0 +1,229 @@
+/**
+ * MinHeap: the allocations and the element copies of the heap operations.
+ * The allocations are counted by replacing the global operator new, and the copies and moves by
+ * an element type (Tracked) that counts them. Each row runs an operation on n elements:
+ * building a heap from a dynamic array by copying it or by adopting its buffer, giving the buffer
+ * back, growing from a small capacity, inserting and emplacing elements, and sorting a dynamic
+ * array in place against sorting a copy of it (what heapSort did when it took the array by value).
+ * Usage: ./heap_allocations_bench [size]
+ */
+
+#include "bench.h"
+#include "heaps/MinHeap.h"
+#include "lists/DynamicArray.h"
+#include <new>
+#include <string>
+
+namespace
+{
+	long long allocations = 0;
+	long long allocated = 0;
+
+	long long copies = 0;
+	long long moves = 0;
+
+	/**
+	 * @brief an element with a payload on the heap, that counts its copies and moves.
+	 */
+	struct Tracked
+	{
+		int key;
+		std::string payload;
+
+		Tracked() : key(0) {}
+
+		Tracked(int k, const char* text) : key(k), payload(text) {}
+
+		Tracked(const Tracked& other) : key(other.key), payload(other.payload) { copies++; }
+
+		Tracked(Tracked&& other) : key(other.key), payload(std::move(other.payload)) { moves++; }
+
+		Tracked& operator=(const Tracked& other)
+		{
+			key = other.key;
+			payload = other.payload;
+			copies++;
+
+			return *this;
+		}
+
+		Tracked& operator=(Tracked&& other)
+		{
+			key = other.key;
+			payload = std::move(other.payload);
+			moves++;
+
+			return *this;
+		}
+
+		bool operator<(const Tracked& other) const { return key < other.key; }
+
+		bool operator>(const Tracked& other) const { return key > other.key; }
+
+		bool operator==(const Tracked& other) const { return key == other.key; }
+
+		bool operator!=(const Tracked& other) const { return key != other.key; }
+	};
+
+	const char* const PAYLOAD = "a payload longer than the small string buffer";
+
+	/**
+	 * @brief run an operation and print its time and allocations, and the bytes, copies and moves
+	 * per element.
+	 */
+	template<typename F>
+	void measure(const char* name, int size, F f)
+	{
+		long long startAllocations = allocations, startBytes = allocated, startCopies = copies, startMoves = moves;
+
+		double ms = bench::best(1, f);
+
+		printf("  %-40s %9.2f ms %8lld %10.1f %8.2f %8.2f\n", name, ms,
+				allocations - startAllocations, (double)(allocated - startBytes) / size,
+				(double)(copies - startCopies) / size, (double)(moves - startMoves) / size);
+	}
+
+	template<typename T>
+	DynamicArray<T> randomArray(int size);
+
+	template<>
+	DynamicArray<int> randomArray<int>(int size)
+	{
+		DynamicArray<int> arr(size);
+
+		for (int i = 0; i < size; i++)
+		{
+			arr.add((int)((i * 2654435761u) % size));
+		}
+
+		return arr;
+	}
+
+	template<>
+	DynamicArray<Tracked> randomArray<Tracked>(int size)
+	{
+		DynamicArray<Tracked> arr(size);
+
+		for (int i = 0; i < size; i++)
+		{
+			arr.add(Tracked((int)((i * 2654435761u) % size), PAYLOAD));
+		}
+
+		return arr;
+	}
+
+	/**
+	 * @brief build an element in its slot from the arguments of its constructor.
+	 */
+	void emplaceKey(MinHeap<int>& heap, int key)
+	{
+		heap.emplace(key);
+	}
+
+	void emplaceKey(MinHeap<Tracked>& heap, int key)
+	{
+		heap.emplace(key, PAYLOAD);
+	}
+
+	template<typename T>
+	void run(int size, T (*make)(int key))
+	{
+		printf("  %-40s %12s %8s %10s %8s %8s\n", "", "", "allocs", "bytes", "copies", "moves");
+
+		DynamicArray<T> arr = randomArray<T>(size);
+
+		measure("build from a const DynamicArray& (copy)", size, [&]()
+		{
+			MinHeap<T> heap(arr);
+
+			bench::check(heap.size() == size, "wrong heap size");
+		});
+
+		DynamicArray<T> spare = randomArray<T>(size);
+
+		measure("build from a DynamicArray&& (adopt)", size, [&]()
+		{
+			MinHeap<T> heap(std::move(spare));
+			DynamicArray<T> back = heap.release();
+
+			bench::check(back.size() == size && spare.size() == 0, "the buffer was not moved");
+		});
+
+		measure("insert into MinHeap(16), growing", size, [&]()
+		{
+			MinHeap<T> heap(16);
+
+			for (int i = 0; i < size; i++)
+			{
+				heap.insert(make(i));
+			}
+		});
+
+		measure("insert into MinHeap(n)", size, [&]()
+		{
+			MinHeap<T> heap(size);
+
+			for (int i = 0; i < size; i++)
+			{
+				heap.insert(make(i));
+			}
+		});
+
+		measure("emplace into MinHeap(n)", size, [&]()
+		{
+			MinHeap<T> heap(size);
+
+			for (int i = 0; i < size; i++)
+			{
+				emplaceKey(heap, i);
+			}
+		});
+
+		measure("heapSort a copy (the old by-value call)", size, [&]()
+		{
+			DynamicArray<T> copy(arr);
+
+			MinHeap<T>::heapSort(copy);
+		});
+
+		measure("heapSort in place", size, [&]() { MinHeap<T>::heapSort(arr); });
+
+		for (int i = 1; i < size; i++)
+		{
+			bench::check(!(arr.get(i - 1) < arr.get(i)), "the array is not sorted (decreasing)");
+		}
+	}
+}
+
+void* operator new(size_t size)
+{
+	allocations++;
+	allocated += size;
+
+	void* block = malloc(size ? size : 1);
+
+	if (!block)
+	{
+		throw std::bad_alloc();
+	}
+
+	return block;
+}
+
+void operator delete(void* block) noexcept
+{
+	free(block);
+}
+
+int main(int argc, char** argv)
+{
+	int size = (int)bench::argument(argc, argv, 1, 1000000);
+
+	printf("%d ints (allocations in total, the rest per element)\n", size);
+	run<int>(size, [](int key) { return key; });
+
+	printf("\n%d Tracked elements with a %d byte string payload\n", size / 5, (int)std::string(PAYLOAD).size());
+	run<Tracked>(size / 5, [](int key) { return Tracked(key, PAYLOAD); });
+
+	return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * Sort::mergeSort (powersort) on partially sorted and random inputs, against std::stable_sort
+ * (the other stable O(n log n) sort) and Sort::quickSort (not stable).
+ * The inputs: random keys, sorted, reversed, a sorted log with 1% random keys appended, 64
+ * sorted runs one after the other, and a sorted array where 1% of the keys moved by up to 16
+ * places - the one case where Sort::insertionSort is fast, so it is timed there too.
+ * Each sort runs on a fresh copy and the result is checked; mergeSort is also checked to be
+ * stable on records with few distinct keys.
+ * Usage: ./merge_sort_bench [size]
+ */
+
+#include "bench.h"
+#include "Sort.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	/** A record ordered by its key only, the id gives its place in the input. */
+	struct Record
+	{
+		int key;
+		int id;
+	};
+
+	struct ByKey
+	{
+		bool operator()(const Record& a, const Record& b) const
+		{
+			return a.key < b.key;
+		}
+	};
+
+	std::vector<int> pattern(const std::string& kind, int size)
+	{
+		std::mt19937 random(size);
+		std::vector<int> keys(size);
+
+		for (int i = 0; i < size; i++)
+		{
+			keys[i] = kind == "random" ? (int)(random() >> 1) : kind == "reversed" ? size - i : i;
+		}
+
+		if (kind == "sorted log + 1% appended")
+		{
+			for (int i = size - size / 100; i < size; i++)
+			{
+				keys[i] = (int)(random() % size);
+			}
+		}
+		else if (kind == "64 sorted runs")
+		{
+			for (int i = 0; i < size; i++)
+			{
+				keys[i] = (int)((long long)(i % (size / 64)) * 64 + random() % 64);
+			}
+
+			for (int r = 0; r < 64; r++)
+			{
+				std::sort(keys.begin() + (long long)r * (size / 64), keys.begin() + (long long)(r + 1) * (size / 64));
+			}
+		}
+		else if (kind == "1% moved by <= 16")
+		{
+			for (int i = 0; i < size / 100; i++)
+			{
+				int from = (int)(random() % (size - 16));
+
+				std::swap(keys[from], keys[from + 1 + random() % 16]);
+			}
+		}
+
+		return keys;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int size = (int)bench::argument(argc, argv, 1, 4000000);
+
+	printf("%d ints (the speedups are over std::stable_sort)\n", size);
+
+	for (const char* name : { "random", "sorted", "reversed", "sorted log + 1% appended", "64 sorted runs", "1% moved by <= 16" })
+	{
+		std::vector<int> keys = pattern(name, size), expected(keys), arr;
+
+		std::sort(expected.begin(), expected.end());
+
+		printf("\n  %s\n", name);
+
+		double stl = bench::best(3, [&]() { arr = keys; }, [&]() { std::stable_sort(arr.begin(), arr.end()); });
+
+		bench::row("std::stable_sort", stl);
+
+		double ms = bench::best(3, [&]() { arr = keys; }, [&]() { Sort<int>::quickSort(arr.data(), size); });
+
+		bench::check(arr == expected, "quickSort");
+		bench::row("Sort::quickSort (not stable)", ms, stl);
+
+		ms = bench::best(3, [&]() { arr = keys; }, [&]() { Sort<int>::mergeSort(arr.data(), size); });
+
+		bench::check(arr == expected, "mergeSort");
+		bench::row("Sort::mergeSort", ms, stl);
+
+		if (std::string(name) == "1% moved by <= 16" || std::string(name) == "sorted")
+		{
+			ms = bench::best(3, [&]() { arr = keys; }, [&]() { Sort<int>::insertionSort(arr.data(), size); });
+
+			bench::check(arr == expected, "insertionSort");
+			bench::row("Sort::insertionSort", ms, stl);
+		}
+	}
+
+	std::vector<int> keys = pattern("sorted log + 1% appended", size);
+	std::vector<Record> records(size), arr;
+
+	for (int i = 0; i < size; i++)
+	{
+		records[i].key = keys[i] / 64;
+		records[i].id = i;
+	}
+
+	Sort<Record>::mergeSort(records.data(), size, ByKey());
+
+	for (int i = 1; i < size; i++)
+	{
+		bench::check(records[i - 1].key < records[i].key ||
+				(records[i - 1].key == records[i].key && records[i - 1].id < records[i].id), "mergeSort is not stable");
+	}
+
+	return 0;
+}
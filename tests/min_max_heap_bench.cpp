@@ -0,0 +1,204 @@
+/**
+ * MinMaxHeap: a double-ended priority queue in one heap, against a MinHeap and a MaxHeap kept
+ * over the same keys (what getting both extremes took before MinMaxHeap).
+ * The two heaps cannot remove a key from the other one, so a key taken from one heap is marked
+ * as gone and skipped when it reaches the top of the other (lazy deletion); each key carries an
+ * id in its low bits for that. The workloads: building from a dynamic array, a random mix of
+ * inserts, extractMins and extractMaxs, and draining from both ends. Both must pop the same keys.
+ * Usage: ./min_max_heap_bench [size]
+ */
+
+#include "bench.h"
+#include "heaps/MaxHeap.h"
+#include "heaps/MinHeap.h"
+#include "heaps/MinMaxHeap.h"
+#include "lists/DynamicArray.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+	const int ID_BITS = 24;
+
+	/**
+	 * @brief a MinHeap and a MaxHeap over the same keys, with lazy deletion.
+	 */
+	struct TwoHeaps
+	{
+		MinHeap<long long> low;
+		MaxHeap<long long> high;
+		std::vector<bool> gone;
+
+		explicit TwoHeaps(const DynamicArray<long long>& keys) : low(keys), high(keys), gone(1 << ID_BITS, false) {}
+
+		void insert(long long key)
+		{
+			low.insert(key);
+			high.insert(key);
+		}
+
+		long long extractMin()
+		{
+			long long key = low.extractMin();
+
+			while (gone[key & ((1 << ID_BITS) - 1)])
+			{
+				key = low.extractMin();
+			}
+
+			gone[key & ((1 << ID_BITS) - 1)] = true;
+
+			return key;
+		}
+
+		long long extractMax()
+		{
+			long long key = high.extractMax();
+
+			while (gone[key & ((1 << ID_BITS) - 1)])
+			{
+				key = high.extractMax();
+			}
+
+			gone[key & ((1 << ID_BITS) - 1)] = true;
+
+			return key;
+		}
+
+		// the entries both heaps hold, the stale ones included
+		int entries()
+		{
+			return low.size() + high.size();
+		}
+	};
+
+	long long makeKey(std::mt19937& random, int id)
+	{
+		return (long long)(random() % (1u << 30)) << ID_BITS | id;
+	}
+
+	/**
+	 * @brief the random mix: half inserts, a quarter extractMins and a quarter extractMaxs.
+	 * @return the sum of the popped keys.
+	 */
+	template<typename H>
+	long long mix(H& heap, int size, int operations)
+	{
+		std::mt19937 random(2);
+		long long sum = 0;
+		int live = size, id = size;
+
+		for (int i = 0; i < operations; i++)
+		{
+			unsigned choice = random() % 4;
+
+			if (choice < 2 || live == 0)
+			{
+				heap.insert(makeKey(random, id++));
+				live++;
+			}
+			else
+			{
+				sum += choice == 2 ? heap.extractMin() : -heap.extractMax();
+				live--;
+			}
+		}
+
+		return sum;
+	}
+
+	/**
+	 * @brief pop all the keys, a min. and a max. in turn.
+	 * @return the sum of the popped keys.
+	 */
+	template<typename H>
+	long long drain(H& heap, int count)
+	{
+		long long sum = 0;
+
+		for (int i = 0; i < count; i++)
+		{
+			sum += i % 2 == 0 ? heap.extractMin() : -heap.extractMax();
+		}
+
+		return sum;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int size = (int)bench::argument(argc, argv, 1, 1000000);
+	int operations = 4 * size;
+
+	std::mt19937 random(1);
+	DynamicArray<long long> keys(size);
+
+	for (int id = 0; id < size; id++)
+	{
+		keys.add(makeKey(random, id));
+	}
+
+	printf("%d keys, %d operations in the mix (half inserts)\n", size, operations);
+
+	double two = bench::best(3, [&]()
+	{
+		TwoHeaps heaps(keys);
+
+		bench::check(heaps.entries() == 2 * size, "wrong heap sizes");
+	});
+
+	bench::row("build MinHeap + MaxHeap", two);
+
+	double ms = bench::best(3, [&]()
+	{
+		MinMaxHeap<long long> heap(keys);
+
+		bench::check(heap.size() == size, "wrong heap size");
+	});
+
+	bench::row("build MinMaxHeap", ms, two);
+
+	long long expected = 0, sum = 0;
+	int entries = 0, live = 0;
+
+	two = bench::best(1, [&]()
+	{
+		TwoHeaps heaps(keys);
+
+		expected = mix(heaps, size, operations);
+		entries = heaps.entries();
+	});
+
+	ms = bench::best(1, [&]()
+	{
+		MinMaxHeap<long long> heap(keys);
+
+		sum = mix(heap, size, operations);
+		live = heap.size();
+	});
+
+	bench::check(sum == expected, "MinMaxHeap popped other keys in the mix");
+	printf("\n(after the mix the two heaps hold %d entries for %d keys)\n", entries, live);
+	bench::row("mix on MinHeap + MaxHeap", two);
+	bench::row("mix on MinMaxHeap", ms, two);
+
+	two = bench::best(1, [&]()
+	{
+		TwoHeaps heaps(keys);
+
+		expected = drain(heaps, size);
+	});
+
+	ms = bench::best(1, [&]()
+	{
+		MinMaxHeap<long long> heap(keys);
+
+		sum = drain(heap, size);
+	});
+
+	bench::check(sum == expected, "MinMaxHeap popped other keys in the drain");
+	bench::row("build + drain MinHeap + MaxHeap", two);
+	bench::row("build + drain MinMaxHeap", ms, two);
+
+	return 0;
+}
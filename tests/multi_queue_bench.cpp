@@ -0,0 +1,185 @@
+/**
+ * MultiQueue: throughput with 1, 2, 4, ... threads against a MinHeap behind a mutex, and the
+ * quality of the relaxed order.
+ * Throughput: the queue starts with n keys, and the threads split a fixed number of operations,
+ * each a push of a random key followed by a pop (strong scaling).
+ * Quality: one thread pushes and pops on queues built for p threads (2 * p heaps, the default c), and the rank
+ * error of a pop is the number of keys in the queue that come before the popped one (0 for an
+ * exact queue); a SkipList of the keys gives the ranks.
+ * Speedups only mean something on a machine with several cores; with one hardware thread the
+ * threads just take turns.
+ * Usage: ./multi_queue_bench [keys] [operations] [maximum threads]
+ */
+
+#include "bench.h"
+#include "heaps/MinHeap.h"
+#include "heaps/MultiQueue.h"
+#include "lists/skip_list/SkipList.h"
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief the exact queue, one call at a time.
+	 */
+	struct Locked
+	{
+		MinHeap<long long> heap;
+		std::mutex lock;
+
+		explicit Locked(int threads) : heap(16) {}
+
+		void push(long long key)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			heap.insert(key);
+		}
+
+		bool tryPopMin(long long& key)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			if (heap.isEmpty())
+			{
+				return false;
+			}
+
+			key = heap.extractMin();
+
+			return true;
+		}
+	};
+
+	template<typename Q>
+	double run(int keys, int operations, int threads)
+	{
+		Q queue(threads);
+		std::mt19937 random(1);
+
+		for (int i = 0; i < keys; i++)
+		{
+			queue.push((long long)random());
+		}
+
+		std::vector<std::thread> workers;
+		std::vector<long long> sums(threads);
+
+		return bench::best(1, [&]()
+		{
+			for (int t = 0; t < threads; t++)
+			{
+				workers.push_back(std::thread([&, t]()
+				{
+					std::mt19937 local(t + 2);
+					long long sum = 0, key;
+
+					for (int i = t; i < operations; i += threads)
+					{
+						queue.push((long long)local());
+
+						if (queue.tryPopMin(key))
+						{
+							sum += key;
+						}
+					}
+
+					sums[t] = sum;
+				}));
+			}
+
+			for (std::thread& worker : workers)
+			{
+				worker.join();
+			}
+
+			for (long long sum : sums)
+			{
+				bench::keep(sum);
+			}
+		});
+	}
+
+	template<typename Q>
+	void scale(const char* name, int keys, int operations, int maximum)
+	{
+		double single = 0;
+
+		printf("  %s\n", name);
+
+		for (int threads = 1; threads <= maximum; threads *= 2)
+		{
+			double ms = run<Q>(keys, operations, threads);
+
+			if (threads == 1)
+			{
+				single = ms;
+			}
+
+			printf("    %2d threads %10.2f ms %8.2f Mops/s  %6.2fx\n", threads, ms, operations / ms / 1000, single / ms);
+		}
+	}
+
+	/**
+	 * @brief the mean and the maximal rank error of the pops of a queue built for some threads.
+	 */
+	void quality(int keys, int operations, int threads)
+	{
+		MultiQueue<long long> queue(threads);
+		SkipList<long long> ranks;
+		std::mt19937 random(3);
+		long long total = 0, worst = 0, key;
+
+		// unique keys: a random high part and a counter
+		for (int i = 0; i < keys; i++)
+		{
+			key = (long long)(random() >> 8) << 32 | i;
+			queue.push(key);
+			ranks.insert(key);
+		}
+
+		for (int i = 0; i < operations; i++)
+		{
+			key = (long long)(random() >> 8) << 32 | (keys + i);
+			queue.push(key);
+			ranks.insert(key);
+
+			bench::check(queue.tryPopMin(key), "the queue is empty");
+
+			long long error = ranks.rank(key) - 1;
+
+			ranks.remove(key);
+			total += error;
+			worst = std::max(worst, error);
+		}
+
+		printf("    p = %2d (%3d heaps)   mean rank error %8.2f   max %6lld\n", threads, 2 * threads, (double)total / operations, worst);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int hardware = (int)std::thread::hardware_concurrency();
+
+	int keys = (int)bench::argument(argc, argv, 1, 1000000);
+	int operations = (int)bench::argument(argc, argv, 2, 2000000);
+	int maximum = (int)bench::argument(argc, argv, 3, std::max(hardware, 4));
+
+	printf("%d keys, %d push + pop pairs, %d hardware threads\n\nthroughput\n", keys, operations, hardware);
+
+	scale<MultiQueue<long long> >("MultiQueue", keys, operations, maximum);
+	scale<Locked>("MinHeap + mutex", keys, operations, maximum);
+
+	printf("\nquality (one thread, %d keys, %d push + pop pairs)\n", keys / 10, operations / 20);
+
+	for (int threads = 1; threads <= std::max(maximum, 8); threads *= 2)
+	{
+		quality(keys / 10, operations / 20, threads);
+	}
+
+	return 0;
+}
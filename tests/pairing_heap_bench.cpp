@@ -0,0 +1,229 @@
+/**
+ * PairingHeap: meld-heavy and decrease-key-heavy workloads, against the array heaps.
+ * Meld-heavy: in each round many small heaps are filled, then merged into one main heap, which
+ * then gives up half or 1% of its keys. A PairingHeap melds in O(1); MinHeap gives its buffer back
+ * (release) and DaryHeap shows its slots (data), and their keys are inserted one by one.
+ * Decrease-key-heavy: a heap of n keys takes random decreaseKeys on live keys, small or large
+ * ones, with an extractTop for every 10 operations; the array heap here is IndexedMinHeap, which
+ * has handles.
+ * Each key carries an id in its low bits, so the workloads are the same on every heap and the
+ * keys that come out can be compared.
+ * Usage: ./pairing_heap_bench [keys]
+ */
+
+#include "bench.h"
+#include "heaps/DaryHeap.h"
+#include "heaps/IndexedMinHeap.h"
+#include "heaps/MinHeap.h"
+#include "heaps/PairingHeap.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+	const int PRODUCERS = 100;      // the heaps merged into the main heap in a round
+	const int ID_BITS = 24;
+
+	/**
+	 * @brief the meld-heavy rounds, on a main heap and producer heaps of type H.
+	 * @param popPercent the percentage of the main heap's keys popped after each round's merges.
+	 * @param merging gets the time in milliseconds spent in the merges.
+	 * @return the sum of the keys that came out.
+	 */
+	template<typename H, typename Merge, typename Pop>
+	long long melds(int keys, int rounds, int popPercent, double& merging, Merge merge, Pop pop)
+	{
+		std::mt19937 random(1);
+		int perProducer = keys / PRODUCERS / rounds > 0 ? keys / PRODUCERS / rounds : 1;
+		long long sum = 0;
+
+		H main;
+
+		for (int r = 0; r < rounds; r++)
+		{
+			for (int p = 0; p < PRODUCERS; p++)
+			{
+				H producer;
+
+				for (int i = 0; i < perProducer; i++)
+				{
+					producer.insert((long long)(random() % (1u << 30)));
+				}
+
+				merging += bench::best(1, [&]() { merge(main, producer); });
+			}
+
+			for (int i = 0, count = (int)((long long)main.size() * popPercent / 100); i < count; i++)
+			{
+				sum += pop(main);
+			}
+		}
+
+		return sum;
+	}
+
+	void row(const char* name, double ms, double merging, double baseline = 0, double baselineMerging = 0)
+	{
+		printf("  %-32s %9.2f ms, merges %9.2f ms", name, ms, merging);
+
+		if (baseline > 0)
+		{
+			printf("  %6.2fx, merges %8.2fx", baseline / ms, baselineMerging / merging);
+		}
+
+		printf("\n");
+	}
+
+	/**
+	 * @brief a MinHeap that starts small, as the other heaps do (MinHeap takes a capacity).
+	 */
+	struct MinHeapOfKeys : public MinHeap<long long>
+	{
+		MinHeapOfKeys() : MinHeap<long long>(16) {}
+	};
+
+	/**
+	 * @brief the decrease-key-heavy workload on a heap with handles.
+	 * @param large whether a key drops to a random priority below its own, or by at most 1024.
+	 * @return the sum of the keys that came out.
+	 */
+	template<typename H, typename Handle, typename Extract>
+	long long decreases(int keys, int operations, bool large, Extract extract)
+	{
+		std::mt19937 random(2);
+		std::vector<Handle> handles(keys);
+		std::vector<long long> key(keys);
+		std::vector<int> live(keys), slot(keys);
+		long long sum = 0;
+
+		H heap;
+
+		for (int id = 0; id < keys; id++)
+		{
+			key[id] = ((long long)(1u << 30) + random() % (1u << 30)) << ID_BITS | id;
+			handles[id] = heap.insert(key[id]);
+			live[id] = id;
+			slot[id] = id;
+		}
+
+		int count = keys;
+
+		for (int i = 0; i < operations && count > 0; i++)
+		{
+			if (i % 10 == 9)
+			{
+				long long top = extract(heap);
+				int id = (int)(top & ((1 << ID_BITS) - 1));
+
+				// take the id out of the live ids
+				live[slot[id]] = live[--count];
+				slot[live[slot[id]]] = slot[id];
+				sum += top;
+			}
+			else
+			{
+				int id = live[random() % count];
+
+				long long priority = key[id] >> ID_BITS;
+
+				priority = large ? (priority > 0 ? (long long)(random() % priority) : 0) : priority - 1 - random() % 1024;
+				key[id] = priority << ID_BITS | id;
+				heap.decreaseKey(handles[id], key[id]);
+			}
+		}
+
+		return sum;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int keys = (int)bench::argument(argc, argv, 1, 1000000);
+	int rounds = 10;
+
+	printf("meld-heavy: %d rounds, %d producer heaps of %d keys each per round\n",
+			rounds, PRODUCERS, keys / PRODUCERS / rounds);
+	printf("(the total time and the time of the merges; the speedup is the one of PairingHeap)\n");
+
+	for (int popPercent : { 50, 1 })
+	{
+		long long expected = 0, sum = 0;
+		double merging = 0, minHeapMerging = 0;
+
+		printf("\n  then pop %d%% of the main heap\n", popPercent);
+
+		double minHeap = bench::best(1, [&]()
+		{
+			expected = melds<MinHeapOfKeys>(keys, rounds, popPercent, minHeapMerging,
+					[](MinHeapOfKeys& main, MinHeapOfKeys& other)
+					{
+						DynamicArray<long long> items = other.release();
+
+						for (int i = 0; i < items.size(); i++)
+						{
+							main.insert(items.get(i));
+						}
+					},
+					[](MinHeapOfKeys& main) { return main.extractMin(); });
+		});
+
+		row("MinHeap (insert each key)", minHeap, minHeapMerging);
+
+		double ms = bench::best(1, [&]()
+		{
+			sum = melds<DaryHeap<long long, 4> >(keys, rounds, popPercent, merging,
+					[](DaryHeap<long long, 4>& main, DaryHeap<long long, 4>& other)
+					{
+						for (int i = 0; i < other.size(); i++)
+						{
+							main.insert(other.data()[i]);
+						}
+					},
+					[](DaryHeap<long long, 4>& main) { return main.extractTop(); });
+		});
+
+		bench::check(sum == expected, "DaryHeap popped other keys");
+		row("DaryHeap<4> (insert each key)", ms, merging);
+
+		merging = 0;
+		ms = bench::best(1, [&]()
+		{
+			sum = melds<PairingHeap<long long> >(keys, rounds, popPercent, merging,
+					[](PairingHeap<long long>& main, PairingHeap<long long>& other) { main.meld(other); },
+					[](PairingHeap<long long>& main) { return main.extractTop(); });
+		});
+
+		bench::check(sum == expected, "PairingHeap popped other keys");
+		row("PairingHeap (meld)", ms, merging, minHeap, minHeapMerging);
+	}
+
+	int operations = 2 * keys;
+
+	printf("\ndecrease-key-heavy: %d keys, %d operations (9 decreaseKeys for each extractTop)\n", keys, operations);
+
+	for (bool large : { false, true })
+	{
+		long long expected = 0, sum = 0;
+
+		printf("\n  %s\n", large ? "large decreases (to a random priority below the key's)" : "small decreases (by up to 1024)");
+
+		double indexed = bench::best(1, [&]()
+		{
+			expected = decreases<IndexedMinHeap<long long>, int>(keys, operations, large,
+					[](IndexedMinHeap<long long>& heap) { return heap.extractMin(); });
+		});
+
+		bench::row("IndexedMinHeap", indexed);
+
+		double ms = bench::best(1, [&]()
+		{
+			sum = decreases<PairingHeap<long long>, PairingHeap<long long>::Handle>(keys, operations, large,
+					[](PairingHeap<long long>& heap) { return heap.extractTop(); });
+		});
+
+		bench::check(sum == expected, "PairingHeap popped other keys");
+		bench::row("PairingHeap", ms, indexed);
+	}
+
+	return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * A strong scaling benchmark for Sort::parallelSort.
+ * The same arrays (uniform keys, and keys with few distinct values, which go to equality
+ * buckets) are sorted with 1, 2, 4, ... threads up to the hardware threads, and the speedup
+ * over one thread is printed next to the time of quickSort on the calling thread.
+ * Speedups only mean something on a machine with several cores; with one hardware thread
+ * the threads just take turns.
+ * Build and run with "make scaling", optionally with the number of keys: ./parallel_sort_scaling 50000000
+ */
+
+#include "Sort.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	const int REPEATS = 3;      // the best of them is printed
+
+	void check(bool condition, const char* message)
+	{
+		if (!condition)
+		{
+			fprintf(stderr, "FAILED: %s\n", message);
+			exit(1);
+		}
+	}
+
+	/**
+	 * @brief the best time in milliseconds of sorting a copy of the keys.
+	 * @param threads 0 for quickSort on the calling thread.
+	 */
+	double measure(const std::vector<int>& keys, int threads)
+	{
+		double best = 0;
+
+		for (int r = 0; r < REPEATS; r++)
+		{
+			std::vector<int> copy(keys);
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			if (threads == 0)
+			{
+				Sort<int>::quickSort(copy.data(), (int)copy.size());
+			}
+			else
+			{
+				Sort<int>::parallelSort(copy.data(), (int)copy.size(), threads);
+			}
+
+			double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			check(std::is_sorted(copy.begin(), copy.end()), "the keys are not sorted");
+
+			if (r == 0 || time < best)
+			{
+				best = time;
+			}
+		}
+
+		return best;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int size = argc > 1 ? atoi(argv[1]) : 20000000;
+	int hardware = (int)std::thread::hardware_concurrency();
+	std::mt19937 random(1);
+
+	printf("%d keys, %d hardware threads\n", size, hardware);
+
+	const int distinct[] = { 0, 1000, 3 };     // 0 for uniform keys
+
+	for (int d : distinct)
+	{
+		std::vector<int> keys(size);
+
+		for (int i = 0; i < size; i++)
+		{
+			keys[i] = d == 0 ? (int)random() : (int)(random() % d);
+		}
+
+		if (d == 0)
+		{
+			printf("\nuniform keys\n");
+		}
+		else
+		{
+			printf("\n%d distinct keys\n", d);
+		}
+
+		printf("  quickSort      %9.1f ms\n", measure(keys, 0));
+
+		double single = measure(keys, 1);
+
+		for (int threads = 1; threads <= std::max(hardware, 1); threads *= 2)
+		{
+			double time = threads == 1 ? single : measure(keys, threads);
+
+			printf("  %3d threads    %9.1f ms  speedup %.2f\n", threads, time, single / time);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,122 @@
+/**
+ * PersistentVector: a snapshot plus an update, against copying a DynamicArray and updating the copy.
+ * Each step makes a new version with one random item changed, and keeps the original one
+ * readable. The last cases apply a batch of updates through a transient, and read the items.
+ * Usage: ./persistent_vector_bench [updates]
+ */
+
+#include "bench.h"
+#include "lists/DynamicArray.h"
+#include "lists/PersistentVector.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+	void row(const char* name, double ms, int operations)
+	{
+		printf("  %-40s %10.2f ms %12.3f us/op\n", name, ms, 1000 * ms / operations);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int updates = (int)bench::argument(argc, argv, 1, 200000);
+	const int sizes[] = { 1000, 100000, 1000000 };
+
+	for (int size : sizes)
+	{
+		std::vector<int> items(size);
+		std::vector<int> positions(updates);
+		std::mt19937 random(size);
+
+		for (int i = 0; i < size; i++)
+		{
+			items[i] = i;
+		}
+
+		for (int i = 0; i < updates; i++)
+		{
+			positions[i] = (int)(random() % size);
+		}
+
+		printf("\n%d items\n", size);
+
+		// copying the array is O(n), so it runs fewer steps
+		int copies = (int)(100000000LL / size < updates ? 100000000LL / size : updates);
+		DynamicArray<int> array(items.data(), size);
+		long long sum = 0;
+
+		double ms = bench::best(1, [&]()
+		{
+			for (int i = 0; i < copies; i++)
+			{
+				DynamicArray<int> next(array);
+
+				next.set(positions[i], -i);
+				sum += next.get(positions[i]);
+			}
+		});
+
+		bench::keep(sum);
+		bench::check(array.get(positions[0]) == positions[0], "the original array changed");
+		row("DynamicArray copy + set", ms, copies);
+
+		PersistentVector<int> vector(items.data(), size);
+
+		ms = bench::best(1, [&]()
+		{
+			for (int i = 0; i < updates; i++)
+			{
+				PersistentVector<int> next = vector.set(positions[i], -i);
+
+				sum += next.get(positions[i]);
+			}
+		});
+
+		bench::keep(sum);
+		bench::check(vector.get(positions[0]) == positions[0], "the original vector changed");
+		row("PersistentVector set (a new version)", ms, updates);
+
+		ms = bench::best(1, [&]()
+		{
+			PersistentVector<int>::Transient transient = vector.transient();
+
+			for (int i = 0; i < updates; i++)
+			{
+				transient.set(positions[i], -i);
+			}
+
+			vector = transient.persistent();
+		});
+
+		bench::check(vector.get(positions[updates - 1]) == -(updates - 1), "wrong transient update");
+		row("PersistentVector transient set (batch)", ms, updates);
+
+		sum = 0;
+
+		ms = bench::best(3, [&]()
+		{
+			for (int i = 0; i < updates; i++)
+			{
+				sum += vector.get(positions[i]);
+			}
+		});
+
+		bench::keep(sum);
+		row("PersistentVector get", ms, updates);
+
+		ms = bench::best(3, [&]()
+		{
+			for (int i = 0; i < updates; i++)
+			{
+				sum += array.get(positions[i]);
+			}
+		});
+
+		bench::keep(sum);
+		row("DynamicArray get", ms, updates);
+	}
+
+	return 0;
+}
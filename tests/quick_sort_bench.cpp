@@ -0,0 +1,152 @@
+/**
+ * Sort::quickSort (pdqsort) on the usual input patterns, against std::sort and MaxHeap::heapSort
+ * (the only O(n log n) sort before quickSort).
+ * The inputs: random keys, sorted, reversed, random with few distinct keys, an organ pipe
+ * (increasing then decreasing), and sorted with 1% of the keys swapped at random. Each sort runs
+ * on a fresh copy and the result is checked. Then records with a comparator (no operator<, so no
+ * branchless partitioning) against std::sort on the random and few-distinct inputs.
+ * Usage: ./quick_sort_bench [size]
+ */
+
+#include "bench.h"
+#include "Sort.h"
+#include "heaps/MaxHeap.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+	/** A record ordered by its key only. */
+	struct Record
+	{
+		int key;
+		int id;
+	};
+
+	struct ByKey
+	{
+		bool operator()(const Record& a, const Record& b) const
+		{
+			return a.key < b.key;
+		}
+	};
+
+	std::vector<int> pattern(const char* name, int size)
+	{
+		std::mt19937 random(size);
+		std::vector<int> keys(size);
+		std::string kind(name);
+
+		for (int i = 0; i < size; i++)
+		{
+			if (kind == "random")
+			{
+				keys[i] = (int)(random() >> 1);
+			}
+			else if (kind == "few distinct (16)")
+			{
+				keys[i] = (int)(random() % 16);
+			}
+			else if (kind == "reversed")
+			{
+				keys[i] = size - i;
+			}
+			else if (kind == "organ pipe")
+			{
+				keys[i] = i < size / 2 ? i : size - i;
+			}
+			else
+			{
+				keys[i] = i;
+			}
+		}
+
+		if (kind == "sorted, 1% swapped")
+		{
+			for (int i = 0; i < size / 100; i++)
+			{
+				std::swap(keys[random() % size], keys[random() % size]);
+			}
+		}
+
+		return keys;
+	}
+
+	/**
+	 * @brief the best time of sorting a copy of the keys, checked against the sorted keys.
+	 */
+	template<typename Sorter>
+	double measure(const std::vector<int>& keys, const std::vector<int>& expected, const char* name, Sorter sorter)
+	{
+		DynamicArray<int> arr((int)keys.size());
+
+		double ms = bench::best(3, [&]()
+		{
+			arr.clear();
+
+			for (int key : keys)
+			{
+				arr.add(key);
+			}
+		}, [&]() { sorter(arr); });
+
+		for (int i = 0; i < arr.size(); i++)
+		{
+			bench::check(arr.get(i) == expected[i], name);
+		}
+
+		return ms;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int size = (int)bench::argument(argc, argv, 1, 2000000);
+
+	printf("%d ints (the speedups are over std::sort)\n", size);
+
+	for (const char* name : { "random", "sorted", "reversed", "few distinct (16)", "organ pipe", "sorted, 1% swapped" })
+	{
+		std::vector<int> keys = pattern(name, size), expected(keys);
+
+		std::sort(expected.begin(), expected.end());
+
+		printf("\n  %s\n", name);
+
+		double stl = measure(keys, expected, "std::sort", [](DynamicArray<int>& arr) { std::sort(&arr[0], &arr[0] + arr.size()); });
+
+		bench::row("std::sort", stl);
+		bench::row("MaxHeap::heapSort", measure(keys, expected, "MaxHeap::heapSort",
+				[](DynamicArray<int>& arr) { MaxHeap<int>::heapSort(arr); }), stl);
+		bench::row("Sort::quickSort", measure(keys, expected, "Sort::quickSort",
+				[](DynamicArray<int>& arr) { Sort<int>::quickSort(arr); }), stl);
+	}
+
+	printf("\n%d records {key, id} with a comparator\n", size);
+
+	for (const char* name : { "random", "few distinct (16)" })
+	{
+		std::vector<int> keys = pattern(name, size);
+		std::vector<Record> records(size), arr;
+
+		for (int i = 0; i < size; i++)
+		{
+			records[i].key = keys[i];
+			records[i].id = i;
+		}
+
+		printf("\n  %s\n", name);
+
+		double stl = bench::best(3, [&]() { arr = records; }, [&]() { std::sort(arr.begin(), arr.end(), ByKey()); });
+
+		bench::row("std::sort", stl);
+
+		double ms = bench::best(3, [&]() { arr = records; }, [&]() { Sort<Record>::quickSort(arr.data(), size, ByKey()); });
+
+		bench::check(std::is_sorted(arr.begin(), arr.end(), ByKey()), "the records are not sorted");
+		bench::row("Sort::quickSort", ms, stl);
+	}
+
+	return 0;
+}
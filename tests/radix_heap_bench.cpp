@@ -0,0 +1,173 @@
+/**
+ * RadixHeap and BucketQueue: Dijkstra's shortest paths on a large grid graph, against MinHeap.
+ * Every vertex of the grid has an edge to each of its 4 neighbours, with a random weight in
+ * [1, maximum weight]. All the queues use lazy deletion: an improved distance inserts the vertex
+ * again and the stale entries are skipped when they come out. MinHeap compares packed
+ * (distance, vertex) keys; RadixHeap and BucketQueue take the distance as the key and the vertex
+ * as its value. A BucketQueue needs a bucket for every distance, so it is only run when the
+ * distances are small (the longest path along the border is a bound). All the runs must give
+ * the same distances.
+ * Usage: ./radix_heap_bench [grid side] [maximum weight]
+ */
+
+#include "bench.h"
+#include "heaps/BucketQueue.h"
+#include "heaps/MinHeap.h"
+#include "heaps/RadixHeap.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+	const long long UNREACHED = -1;
+	const int BUCKET_LIMIT = 100000000;     // the most buckets BucketQueue is run with
+
+	/**
+	 * @brief a grid of side * side vertices, the edge weights of vertex v are weight[4 * v + d].
+	 */
+	struct Grid
+	{
+		int side;
+		std::vector<int> weight;
+	};
+
+	const int DX[] = { 1, -1, 0, 0 };
+	const int DY[] = { 0, 0, 1, -1 };
+
+	Grid randomGrid(int side, int maximum)
+	{
+		Grid grid;
+		std::mt19937 random(side);
+
+		grid.side = side;
+		grid.weight.resize(4 * (size_t)side * side);
+
+		for (int& w : grid.weight)
+		{
+			w = 1 + (int)(random() % maximum);
+		}
+
+		return grid;
+	}
+
+	/**
+	 * @brief Dijkstra from the corner with lazy deletion.
+	 * @param push inserts a (distance, vertex) entry.
+	 * @param pop extracts the entry of the minimum distance, and gives its vertex.
+	 */
+	template<typename H, typename Push, typename Pop>
+	std::vector<long long> lazy(const Grid& grid, H& heap, long long& operations, Push push, Pop pop)
+	{
+		int side = grid.side;
+		std::vector<long long> dist((size_t)side * side, UNREACHED);
+		std::vector<bool> done((size_t)side * side, false);
+
+		dist[0] = 0;
+		push(heap, 0, 0);
+
+		while (!heap.isEmpty())
+		{
+			int v;
+			long long d = pop(heap, v);
+
+			if (done[v])
+			{
+				continue;
+			}
+
+			done[v] = true;
+
+			int x = v % side, y = v / side;
+
+			for (int e = 0; e < 4; e++)
+			{
+				int nx = x + DX[e], ny = y + DY[e];
+
+				if (nx < 0 || ny < 0 || nx >= side || ny >= side)
+				{
+					continue;
+				}
+
+				int u = ny * side + nx;
+				long long next = d + grid.weight[4 * v + e];
+
+				if (done[u] || (dist[u] != UNREACHED && dist[u] <= next))
+				{
+					continue;
+				}
+
+				dist[u] = next;
+				push(heap, next, u);
+				operations++;
+			}
+		}
+
+		return dist;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int side = (int)bench::argument(argc, argv, 1, 1000);
+	int maximum = (int)bench::argument(argc, argv, 2, 100);
+
+	Grid grid = randomGrid(side, maximum);
+	std::vector<long long> expected, dist;
+	long long updates = 0;
+
+	printf("a %d x %d grid, weights in [1, %d] (times for one source)\n", side, side, maximum);
+
+	double minHeap = bench::best(3, [&]() { updates = 0; }, [&]()
+	{
+		MinHeap<long long> heap(16);
+
+		expected = lazy(grid, heap, updates,
+				[](MinHeap<long long>& heap, long long d, int v) { heap.insert(d << 32 | v); },
+				[](MinHeap<long long>& heap, int& v)
+				{
+					long long entry = heap.extractMin();
+
+					v = (int)(entry & 0xffffffff);
+
+					return entry >> 32;
+				});
+	});
+
+	printf("  (%lld inserts)\n", updates);
+	bench::row("MinHeap of packed keys", minHeap);
+
+	double ms = bench::best(3, [&]()
+	{
+		RadixHeap<int> heap;
+
+		dist = lazy(grid, heap, updates,
+				[](RadixHeap<int>& heap, long long d, int v) { heap.insert((uint64_t)d, v); },
+				[](RadixHeap<int>& heap, int& v) { return (long long)heap.extractMin(v); });
+	});
+
+	bench::check(dist == expected, "RadixHeap gives other distances");
+	bench::row("RadixHeap", ms, minHeap);
+
+	long long range = 2LL * side * maximum;
+
+	if (range > BUCKET_LIMIT)
+	{
+		printf("  BucketQueue skipped: %lld buckets\n", range);
+
+		return 0;
+	}
+
+	ms = bench::best(3, [&]()
+	{
+		BucketQueue<int> heap((int)range);
+
+		dist = lazy(grid, heap, updates,
+				[](BucketQueue<int>& heap, long long d, int v) { heap.insert((int)d, v); },
+				[](BucketQueue<int>& heap, int& v) { return (long long)heap.extractMin(v); });
+	});
+
+	bench::check(dist == expected, "BucketQueue gives other distances");
+	bench::row("BucketQueue", ms, minHeap);
+
+	return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * Sort::radixSort against the comparison sorts (Sort::quickSort, Sort::mergeSort and std::sort)
+ * on random 32 and 64 bit integers, floats and doubles, on 32 bit integers that only use their
+ * low 16 bits (so the pass of the top digit is skipped), and on records sorted by an int field
+ * with a key extractor, where the stable comparison sorts (mergeSort, std::stable_sort) are the
+ * fair comparison. Each result is checked against std::sort (std::stable_sort for the records).
+ * Usage: ./radix_sort_bench [size]
+ */
+
+#include "bench.h"
+#include "Sort.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+	/** A record sorted by its key, the payload makes it 16 bytes. */
+	struct Record
+	{
+		int key;
+		int id;
+		double payload;
+
+		bool operator==(const Record& other) const
+		{
+			return key == other.key && id == other.id;
+		}
+	};
+
+	struct ByKey
+	{
+		bool operator()(const Record& a, const Record& b) const
+		{
+			return a.key < b.key;
+		}
+	};
+
+	/**
+	 * @brief time the sorts of one key type, each on a fresh copy of the keys.
+	 */
+	template<typename T>
+	void run(const char* name, const std::vector<T>& keys)
+	{
+		std::vector<T> arr, expected(keys);
+
+		std::sort(expected.begin(), expected.end());
+
+		printf("\n  %s\n", name);
+
+		double stl = bench::best(3, [&]() { arr = keys; }, [&]() { std::sort(arr.begin(), arr.end()); });
+
+		bench::row("std::sort", stl);
+
+		double ms = bench::best(3, [&]() { arr = keys; }, [&]() { Sort<T>::quickSort(arr.data(), (int)arr.size()); });
+
+		bench::check(arr == expected, "quickSort");
+		bench::row("Sort::quickSort", ms, stl);
+
+		ms = bench::best(3, [&]() { arr = keys; }, [&]() { Sort<T>::mergeSort(arr.data(), (int)arr.size()); });
+
+		bench::check(arr == expected, "mergeSort");
+		bench::row("Sort::mergeSort", ms, stl);
+
+		ms = bench::best(3, [&]() { arr = keys; }, [&]() { Sort<T>::radixSort(arr.data(), (int)arr.size()); });
+
+		bench::check(arr == expected, "radixSort");
+		bench::row("Sort::radixSort", ms, stl);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int size = (int)bench::argument(argc, argv, 1, 4000000);
+
+	std::mt19937_64 random(1);
+	std::vector<int32_t> ints(size), shorts(size);
+	std::vector<int64_t> longs(size);
+	std::vector<float> floats(size);
+	std::vector<double> doubles(size);
+	std::vector<Record> records(size);
+
+	for (int i = 0; i < size; i++)
+	{
+		uint64_t bits = random();
+
+		ints[i] = (int32_t)bits;
+		shorts[i] = (int32_t)(bits & 0xffff);
+		longs[i] = (int64_t)bits;
+		floats[i] = (float)((int32_t)bits) / 1000;
+		doubles[i] = (double)(int64_t)bits / 1e6;
+		records[i].key = (int)(bits >> 40) - (1 << 23);
+		records[i].id = i;
+		records[i].payload = 0;
+	}
+
+	printf("%d keys (the speedups are over std::sort)\n", size);
+
+	run("int32", ints);
+	run("int32 in [0, 65535] (1 of the 3 passes skipped)", shorts);
+	run("int64", longs);
+	run("float", floats);
+	run("double", doubles);
+
+	std::vector<Record> arr, expected(records);
+
+	std::stable_sort(expected.begin(), expected.end(), ByKey());
+
+	printf("\n  16 byte records by an int key (stable)\n");
+
+	double stl = bench::best(3, [&]() { arr = records; }, [&]() { std::stable_sort(arr.begin(), arr.end(), ByKey()); });
+
+	bench::row("std::stable_sort", stl);
+
+	double ms = bench::best(3, [&]() { arr = records; }, [&]() { Sort<Record>::mergeSort(arr.data(), size, ByKey()); });
+
+	bench::check(arr == expected, "mergeSort of the records");
+	bench::row("Sort::mergeSort", ms, stl);
+
+	ms = bench::best(3, [&]() { arr = records; }, [&]()
+	{
+		Sort<Record>::radixSort(arr.data(), size, [](const Record& record) { return record.key; });
+	});
+
+	bench::check(arr == expected, "radixSort of the records");
+	bench::row("Sort::radixSort by key", ms, stl);
+
+	return 0;
+}
@@ -0,0 +1,197 @@
+/**
+ * Rope: random access, inserts and removals at random positions, and split + concat on a large
+ * list, against DynamicArray and DLinkedList.
+ * DynamicArray shifts or copies the tail and DLinkedList walks to the position, so they run
+ * fewer of those operations (1/100 or 1/1000 of them); the table shows the time per operation.
+ * Usage: ./rope_bench [size] [operations]
+ */
+
+#include "bench.h"
+#include "lists/DynamicArray.h"
+#include "lists/Rope.h"
+#include "lists/linked_lists/DLinkedList.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+	void row(const char* name, double ms, int operations)
+	{
+		printf("  %-34s %8d ops %10.2f ms %10.3f us/op\n", name, operations, ms, 1000 * ms / operations);
+	}
+
+	template<typename L>
+	long long getAll(L& list, const std::vector<int>& positions, int count)
+	{
+		long long sum = 0;
+
+		for (int i = 0; i < count; i++)
+		{
+			sum += list.get(positions[i]);
+		}
+
+		return sum;
+	}
+
+	/**
+	 * @brief insert an item at a random position, then remove the item at another one.
+	 */
+	template<typename L>
+	void edit(L& list, const std::vector<int>& positions, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			list.add(i, positions[i]);
+			list.removeAt(positions[count - 1 - i]);
+		}
+	}
+
+	void splitConcat(Rope<int>& rope, const std::vector<int>& positions, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			Rope<int>* tail = rope.split(positions[i]);
+
+			rope.concat(*tail);
+			delete tail;
+		}
+	}
+
+	void splitConcat(DynamicArray<int>& arr, const std::vector<int>& positions, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			DynamicArray<int> tail;
+			int size = arr.size();
+
+			for (int j = positions[i]; j < size; j++)
+			{
+				tail.add(arr.get(j));
+			}
+
+			for (int j = positions[i]; j < size; j++)
+			{
+				arr.removeLast();
+			}
+
+			for (int j = 0; j < tail.size(); j++)
+			{
+				arr.add(tail.get(j));
+			}
+		}
+	}
+
+	void splitConcat(DLinkedList<int>& list, const std::vector<int>& positions, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			DLinkedList<int> tail;
+			DLinkedList<int>::Iterator middle = list.begin();
+			int size = list.size();
+
+			for (int j = 0; j < positions[i]; j++)
+			{
+				++middle;
+			}
+
+			tail.splice(tail.begin(), list, middle, list.end(), size - positions[i]);
+			list.splice(list.end(), tail, tail.begin(), tail.end(), size - positions[i]);
+		}
+	}
+
+	template<typename L>
+	void fill(L& list, const std::vector<int>& items)
+	{
+		for (int item : items)
+		{
+			list.add(item);
+		}
+	}
+
+	/**
+	 * @brief run the three cases on a list, each one a given number of times, and check the list's
+	 * items against the ones of a rope that went through the same edits.
+	 */
+	template<typename L>
+	void run(const char* name, L& list, const std::vector<int>& items, const std::vector<int>& positions,
+			int gets, int edits, int splits)
+	{
+		char label[64];
+
+		double ms = bench::best(1, [&]() { bench::keep(getAll(list, positions, gets)); });
+
+		snprintf(label, sizeof(label), "%s get", name);
+		row(label, ms, gets);
+
+		ms = bench::best(1, [&]() { edit(list, positions, edits); });
+
+		snprintf(label, sizeof(label), "%s add + removeAt", name);
+		row(label, ms, edits);
+
+		ms = bench::best(1, [&]() { splitConcat(list, positions, splits); });
+
+		snprintf(label, sizeof(label), "%s split + concat", name);
+		row(label, ms, splits);
+
+		Rope<int> rope(const_cast<int*>(items.data()), (int)items.size());
+
+		edit(rope, positions, edits);
+		splitConcat(rope, positions, splits);
+
+		for (int i = 0; i < 16; i++)
+		{
+			bench::check(list.get(positions[i]) == rope.get(positions[i]), "the lists differ after the same operations");
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int size = (int)bench::argument(argc, argv, 1, 1000000);
+	int operations = (int)bench::argument(argc, argv, 2, 100000);
+
+	// the lists are compared at the first 16 positions
+	operations = operations > 16 ? operations : 16;
+
+	std::vector<int> items(size);
+	std::vector<int> positions(operations);
+	std::mt19937 random(11);
+
+	for (int i = 0; i < size; i++)
+	{
+		items[i] = i;
+	}
+
+	for (int i = 0; i < operations; i++)
+	{
+		positions[i] = (int)(random() % size);
+	}
+
+	printf("%d items (times per operation)\n\n", size);
+
+	int fewer = operations / 100 > 16 ? operations / 100 : 16;
+	int fewest = operations / 1000 > 16 ? operations / 1000 : 16;
+
+	{
+		Rope<int> rope(items.data(), size);
+
+		run("Rope", rope, items, positions, operations, operations, operations);
+		printf("  (the tree's height is %d)\n\n", rope.getHeight());
+	}
+
+	{
+		DynamicArray<int> arr(items.data(), size);
+
+		run("DynamicArray", arr, items, positions, operations, fewer, fewest);
+		printf("\n");
+	}
+
+	{
+		DLinkedList<int> list;
+
+		fill(list, items);
+		run("DLinkedList", list, items, positions, fewest, fewest, fewest);
+	}
+
+	return 0;
+}
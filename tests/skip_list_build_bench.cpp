@@ -0,0 +1,124 @@
+/**
+ * SkipList: building a list from sorted keys, by repeated inserts, insertBatch and buildFromSorted.
+ * The list is built from the even numbers below 2n. The last cases merge a sorted batch of odd
+ * numbers (a tenth of n) into the built list, by repeated inserts and by insertBatch.
+ * Usage: ./skip_list_build_bench [size]
+ */
+
+#include "bench.h"
+#include "lists/skip_list/SkipList.h"
+#include <vector>
+
+namespace
+{
+	void row(const char* name, double ms, int keys, double baseline = 0)
+	{
+		printf("  %-34s %10.2f ms %8.1f ns/key", name, ms, 1000000 * ms / keys);
+
+		if (baseline > 0)
+		{
+			printf("  %7.2fx", baseline / ms);
+		}
+
+		printf("\n");
+	}
+
+	/**
+	 * @brief check the size of a list and the ranks of a few of its keys.
+	 */
+	void verify(SkipList<int>& list, const std::vector<int>& keys, const char* message)
+	{
+		int size = (int)keys.size();
+
+		bench::check(list.size() == size, message);
+
+		// rank counts the keys up to a key, select takes a 0-based index
+		for (int i = 0; i < size; i += size / 16 + 1)
+		{
+			bench::check(list.rank(keys[i]) == i + 1 && list.select(i) == keys[i], message);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int size = (int)bench::argument(argc, argv, 1, 10000000);
+	int batch = size / 10 > 0 ? size / 10 : 1;
+
+	std::vector<int> keys(size), odd(batch), merged;
+
+	for (int i = 0; i < size; i++)
+	{
+		keys[i] = 2 * i;
+	}
+
+	// spread the batch over the list
+	for (int i = 0; i < batch; i++)
+	{
+		odd[i] = 2 * (int)((long long)i * size / batch) + 1;
+	}
+
+	merged.reserve(size + batch);
+
+	for (int i = 0, j = 0; i < size || j < batch;)
+	{
+		merged.push_back(j == batch || (i < size && keys[i] < odd[j]) ? keys[i++] : odd[j++]);
+	}
+
+	printf("build a list of %d sorted keys\n", size);
+
+	double inserts = 0;
+
+	{
+		SkipList<int> list;
+
+		inserts = bench::best(1, [&]()
+		{
+			for (int key : keys)
+			{
+				list.insert(key);
+			}
+		});
+
+		verify(list, keys, "wrong list after the inserts");
+		row("insert each key", inserts, size);
+	}
+
+	{
+		SkipList<int> list;
+
+		double ms = bench::best(1, [&]() { list.insertBatch(keys.data(), size); });
+
+		verify(list, keys, "wrong list after insertBatch");
+		row("insertBatch", ms, size, inserts);
+	}
+
+	SkipList<int> list;
+
+	double ms = bench::best(1, [&]() { list.buildFromSorted(keys.data(), size); });
+
+	verify(list, keys, "wrong list after buildFromSorted");
+	row("buildFromSorted", ms, size, inserts);
+
+	printf("\nmerge %d sorted keys into the list\n", batch);
+
+	inserts = bench::best(1, [&]()
+	{
+		for (int key : odd)
+		{
+			list.insert(key);
+		}
+	});
+
+	verify(list, merged, "wrong list after merging by inserts");
+	row("insert each key", inserts, batch);
+
+	list.buildFromSorted(keys.data(), size);
+
+	ms = bench::best(1, [&]() { list.insertBatch(odd.data(), batch); });
+
+	verify(list, merged, "wrong list after merging by insertBatch");
+	row("insertBatch", ms, batch, inserts);
+
+	return 0;
+}
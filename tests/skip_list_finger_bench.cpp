@@ -0,0 +1,198 @@
+/**
+ * SkipList: searches from the head against searches through a Finger, on local key streams.
+ * The list holds the even numbers below 2n. A stream is a sequence of positions in the list:
+ * sequential, zipfian-local (a walk whose steps have length d with probability ~ 1/d, up to
+ * n / 100) and uniform (where a finger has nothing to reuse). find, rank and select run on the
+ * keys or positions of a stream, and insert adds the odd number after each key to a fresh list.
+ * Usage: ./skip_list_finger_bench [size] [queries]
+ */
+
+#include "bench.h"
+#include "lists/skip_list/SkipList.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+	void row(const char* name, double head, double finger, int queries)
+	{
+		printf("  %-8s %10.1f ns/op from the head %10.1f ns/op with a finger  %7.2fx\n",
+				name, 1000000 * head / queries, 1000000 * finger / queries, head / finger);
+	}
+
+	std::vector<int> sequential(int size, int count)
+	{
+		std::vector<int> result(count);
+
+		for (int i = 0; i < count; i++)
+		{
+			result[i] = i % size;
+		}
+
+		return result;
+	}
+
+	std::vector<int> zipfianLocal(int size, int count)
+	{
+		std::vector<int> result(count);
+		std::mt19937 random(1);
+		std::uniform_real_distribution<double> unit(0, 1);
+		double longest = std::log(size / 100 > 1 ? size / 100 : 2);
+		int position = size / 2;
+
+		for (int i = 0; i < count; i++)
+		{
+			// a log-uniform length has density ~ 1/d
+			int step = (int)std::exp(unit(random) * longest);
+
+			position += random() % 2 ? step : -step;
+			position = position < 0 ? -position : (position >= size ? 2 * (size - 1) - position : position);
+			result[i] = position;
+		}
+
+		return result;
+	}
+
+	std::vector<int> uniform(int size, int count)
+	{
+		std::vector<int> result(count);
+		std::mt19937 random(2);
+
+		for (int i = 0; i < count; i++)
+		{
+			result[i] = (int)(random() % size);
+		}
+
+		return result;
+	}
+
+	void run(const char* name, const std::vector<int>& keys, const std::vector<int>& positions)
+	{
+		int size = (int)keys.size(), count = (int)positions.size();
+		long long sum = 0, expected = 0;
+
+		SkipList<int> list;
+
+		list.buildFromSorted(keys.data(), size);
+
+		printf("\n%s\n", name);
+
+		// find
+		double head = bench::best(3, [&]() { sum = 0; }, [&]()
+		{
+			for (int p : positions)
+			{
+				sum += list.find(keys[p])->getKey();
+			}
+		});
+
+		expected = sum;
+
+		double finger = bench::best(3, [&]() { sum = 0; }, [&]()
+		{
+			SkipList<int>::Finger cursor;
+
+			for (int p : positions)
+			{
+				sum += list.find(keys[p], cursor)->getKey();
+			}
+		});
+
+		bench::check(sum == expected, "find through a finger differs");
+		row("find", head, finger, count);
+
+		// rank
+		head = bench::best(3, [&]() { sum = 0; }, [&]()
+		{
+			for (int p : positions)
+			{
+				sum += list.rank(keys[p]);
+			}
+		});
+
+		expected = sum;
+
+		finger = bench::best(3, [&]() { sum = 0; }, [&]()
+		{
+			SkipList<int>::Finger cursor;
+
+			for (int p : positions)
+			{
+				sum += list.rank(keys[p], cursor);
+			}
+		});
+
+		bench::check(sum == expected, "rank through a finger differs");
+		row("rank", head, finger, count);
+
+		// select
+		head = bench::best(3, [&]() { sum = 0; }, [&]()
+		{
+			for (int p : positions)
+			{
+				sum += list.select(p);
+			}
+		});
+
+		expected = sum;
+
+		finger = bench::best(3, [&]() { sum = 0; }, [&]()
+		{
+			SkipList<int>::Finger cursor;
+
+			for (int p : positions)
+			{
+				sum += list.select(p, cursor);
+			}
+		});
+
+		bench::check(sum == expected, "select through a finger differs");
+		row("select", head, finger, count);
+
+		// insert, into a fresh list each time
+		head = bench::best(1, [&]() { list.buildFromSorted(keys.data(), size); }, [&]()
+		{
+			for (int p : positions)
+			{
+				list.insert(keys[p] + 1);
+			}
+		});
+
+		expected = list.size();
+
+		finger = bench::best(1, [&]() { list.buildFromSorted(keys.data(), size); }, [&]()
+		{
+			SkipList<int>::Finger cursor;
+
+			for (int p : positions)
+			{
+				list.insert(keys[p] + 1, cursor);
+			}
+		});
+
+		bench::check(list.size() == expected, "insert through a finger differs");
+		row("insert", head, finger, count);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int size = (int)bench::argument(argc, argv, 1, 1000000);
+	int count = (int)bench::argument(argc, argv, 2, 300000);
+
+	std::vector<int> keys(size);
+
+	for (int i = 0; i < size; i++)
+	{
+		keys[i] = 2 * i;
+	}
+
+	printf("%d keys, %d queries per case\n", size, count);
+
+	run("sequential", keys, sequential(size, count));
+	run("zipfian-local", keys, zipfianLocal(size, count));
+	run("uniform", keys, uniform(size, count));
+
+	return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * SkipList: the cost of generating node heights, and of inserts with each generator.
+ * The old generator built a std::random_device and a std::mt19937 for every insert; it is kept
+ * here (oldHeight) to measure it. The list now draws the height from the trailing zeros of one
+ * FastRandom word. The old inserts are timed as an insert plus a call to the old generator, since
+ * the rest of the insert is the same. The last case checks that a seeded list is reproducible.
+ * Usage: ./skip_list_height_bench [inserts]
+ */
+
+#include "bench.h"
+#include "Random.h"
+#include "lists/skip_list/SkipList.h"
+#include <climits>
+#include <random>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief the height generator SkipList used before FastRandom.
+	 */
+	int oldHeight(double prob)
+	{
+		const int limit = INT_MAX;
+		int counter = 1;
+
+		std::random_device rnd;
+		std::mt19937 twister(rnd());
+		std::uniform_int_distribution<> dist(0, limit);
+
+		while (dist(twister) <= limit * prob)
+		{
+			counter++;
+		}
+
+		return counter;
+	}
+
+	void row(const char* name, double ms, int operations, double baseline = 0)
+	{
+		printf("  %-44s %10.2f ms %10.1f ns/op", name, ms, 1000000 * ms / operations);
+
+		if (baseline > 0)
+		{
+			printf("  %7.2fx", baseline / ms);
+		}
+
+		printf("\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int count = (int)bench::argument(argc, argv, 1, 200000);
+
+	std::vector<int> keys(count);
+	std::mt19937 random(5);
+
+	for (int i = 0; i < count; i++)
+	{
+		keys[i] = (int)(random() >> 1);
+	}
+
+	printf("%d heights / inserts of random keys\n\nheights alone (the mean height is ~2 for both)\n", count);
+
+	long long sum = 0;
+
+	double old = bench::best(1, [&]() { sum = 0; }, [&]()
+	{
+		for (int i = 0; i < count; i++)
+		{
+			sum += oldHeight(0.5);
+		}
+	});
+
+	bench::check(sum > 1.8 * count && sum < 2.2 * count, "wrong mean height of the old generator");
+	row("random_device + mt19937 per height (old)", old, count);
+
+	FastRandom fast(1);
+
+	double ms = bench::best(3, [&]() { sum = 0; }, [&]()
+	{
+		for (int i = 0; i < count; i++)
+		{
+			sum += 1 + FastRandom::trailingZeros(fast.next());
+		}
+	});
+
+	bench::check(sum > 1.8 * count && sum < 2.2 * count, "wrong mean height of the fast generator");
+	bench::keep(sum);
+	row("FastRandom trailing zeros (new)", ms, count, old);
+
+	printf("\ninserts\n");
+
+	double inserts = bench::best(1, [&]()
+	{
+		SkipList<int> list;
+
+		for (int key : keys)
+		{
+			list.insert(key);
+			bench::keep(oldHeight(0.5));
+		}
+	});
+
+	row("insert + the old generator", inserts, count);
+
+	ms = bench::best(1, [&]()
+	{
+		SkipList<int> list;
+
+		for (int key : keys)
+		{
+			list.insert(key);
+		}
+	});
+
+	row("insert (prob 0.5, trailing zeros)", ms, count, inserts);
+
+	ms = bench::best(1, [&]()
+	{
+		SkipList<int> list(0.25);
+
+		for (int key : keys)
+		{
+			list.insert(key);
+		}
+	});
+
+	row("insert (prob 0.25, threshold loop)", ms, count, inserts);
+
+	// the same seed and keys give the same height to every node
+	SkipList<int> first, second;
+
+	first.seed(42);
+	second.seed(42);
+
+	for (int key : keys)
+	{
+		first.insert(key);
+		second.insert(key);
+	}
+
+	for (int key : keys)
+	{
+		bench::check(first.find(key)->getHeight() == second.find(key)->getHeight(), "seeded lists differ");
+	}
+
+	printf("\ntwo lists seeded with 42 have the same node heights\n");
+
+	return 0;
+}
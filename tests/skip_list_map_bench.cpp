@@ -0,0 +1,195 @@
+/**
+ * SkipListMap: an ordered map of int keys and values, against the ways it was done before, an
+ * AVLTree and a SkipList of Pairs. A Pair has no order, so Entry adds one that reads the keys
+ * through Pair's checked getKey, the way the maps of pairs compared them.
+ * Each map gets the same random keys, then looks up random keys (about half of them are found),
+ * and the skip lists also answer rank and select. A map of 10K keys runs first, then a larger one.
+ * Usage: ./skip_list_map_bench [size] [queries]
+ */
+
+#include "bench.h"
+#include "Pair.h"
+#include "lists/skip_list/SkipList.h"
+#include "lists/skip_list/SkipListMap.h"
+#include "trees/AVLTree.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief a key and a value, ordered and compared by the key only.
+	 */
+	class Entry : public Pair<int, int>
+	{
+	public:
+		Entry() {}
+
+		Entry(int key, int value) : Pair<int, int>(key, value) {}
+
+		bool operator<(Entry other) { return getKey() < other.getKey(); }
+
+		bool operator<=(Entry other) { return getKey() <= other.getKey(); }
+
+		bool operator>(Entry other) { return getKey() > other.getKey(); }
+
+		bool operator>=(Entry other) { return getKey() >= other.getKey(); }
+
+		bool operator==(Entry other) { return getKey() == other.getKey(); }
+
+		bool operator!=(Entry other) { return getKey() != other.getKey(); }
+	};
+
+	void row(const char* name, double ms, int operations)
+	{
+		printf("    %-36s %10.2f ms %10.1f ns/op\n", name, ms, 1000000 * ms / operations);
+	}
+
+	/**
+	 * @brief fill each map with the same keys and run the queries on it.
+	 */
+	void run(int size, int count)
+	{
+		std::vector<int> keys(size), queries(count), indexes(count);
+		std::mt19937 random(4);
+
+		for (int i = 0; i < size; i++)
+		{
+			keys[i] = 2 * (int)(random() % (1 << 30));
+		}
+
+		for (int i = 0; i < count; i++)
+		{
+			queries[i] = i % 2 ? keys[random() % size] : 2 * (int)(random() % (1 << 30)) + 1;
+			indexes[i] = (int)(random() % size);
+		}
+
+		printf("\n%d random keys, %d lookups (half of them found), %d ranks and selects\n", size, count, count);
+
+		long long expected = 0, sum = 0;
+
+		{
+			printf("  SkipListMap<int, int>\n");
+
+			SkipListMap<int, int> map;
+
+			double ms = bench::best(1, [&]()
+			{
+				for (int key : keys)
+				{
+					map.insert(key, key / 2);
+				}
+			});
+
+			row("insert", ms, size);
+
+			ms = bench::best(3, [&]() { sum = 0; }, [&]()
+			{
+				for (int key : queries)
+				{
+					int* value = map.search(key);
+
+					sum += value ? *value : -1;
+				}
+			});
+
+			expected = sum;
+			row("search", ms, count);
+
+			ms = bench::best(3, [&]() { sum = 0; }, [&]()
+			{
+				for (int i = 0; i < count; i++)
+				{
+					sum += map.rank(queries[i]) + map.select(indexes[i] % map.size());
+				}
+			});
+
+			bench::keep(sum);
+			row("rank + select", ms, count);
+		}
+
+		{
+			printf("  SkipList<Entry>\n");
+
+			SkipList<Entry> list;
+
+			double ms = bench::best(1, [&]()
+			{
+				for (int key : keys)
+				{
+					list.insert(Entry(key, key / 2));
+				}
+			});
+
+			row("insert", ms, size);
+
+			ms = bench::best(3, [&]() { sum = 0; }, [&]()
+			{
+				for (int key : queries)
+				{
+					SkipListNode<Entry>* node = list.find(Entry(key, 0));
+
+					sum += node ? node->getKey().getData() : -1;
+				}
+			});
+
+			bench::check(sum == expected, "the skip list of pairs found other values");
+			row("find", ms, count);
+
+			ms = bench::best(3, [&]() { sum = 0; }, [&]()
+			{
+				for (int i = 0; i < count; i++)
+				{
+					sum += list.rank(Entry(queries[i], 0)) + list.select(indexes[i] % list.size()).getKey();
+				}
+			});
+
+			bench::keep(sum);
+			row("rank + select", ms, count);
+		}
+
+		{
+			printf("  AVLTree<Entry>\n");
+
+			AVLTree<Entry> tree;
+
+			double ms = bench::best(1, [&]()
+			{
+				for (int key : keys)
+				{
+					if (!tree.search(Entry(key, 0)))
+					{
+						tree.insert(Entry(key, key / 2));
+					}
+				}
+			});
+
+			row("search + insert (no repeated keys)", ms, size);
+
+			ms = bench::best(3, [&]() { sum = 0; }, [&]()
+			{
+				for (int key : queries)
+				{
+					AVLTree<Entry>* node = tree.search(Entry(key, 0));
+
+					sum += node ? node->getKey().getData() : -1;
+				}
+			});
+
+			bench::check(sum == expected, "the tree of pairs found other values");
+			row("search", ms, count);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int size = (int)bench::argument(argc, argv, 1, 1000000);
+	int count = (int)bench::argument(argc, argv, 2, 300000);
+
+	// the small maps fit in the cache, where the comparisons are a larger part of the time
+	run(10000, count);
+	run(size, count);
+
+	return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * SkipList: insert, find and rank throughput, and the allocations the nodes cost.
+ * A node is one block (the node and its tower of {next, dist} levels), with the back pointers
+ * only when the list is made with backLinks; it used to be a node plus three DynamicArrays.
+ * The allocations are counted by replacing the global operator new.
+ * Usage: ./skip_list_node_bench [size] [queries]
+ */
+
+#include "bench.h"
+#include "lists/skip_list/SkipList.h"
+#include <algorithm>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace
+{
+	long long allocations = 0;
+	long long allocated = 0;
+
+	void row(const char* name, double ms, int operations)
+	{
+		printf("  %-36s %10.2f ms %10.1f ns/op\n", name, ms, 1000000 * ms / operations);
+	}
+
+	/**
+	 * @brief fill a list and run the queries on it.
+	 */
+	void run(const char* name, bool backLinks, const std::vector<int>& keys, const std::vector<int>& queries)
+	{
+		int size = (int)keys.size(), count = (int)queries.size();
+		char label[64];
+
+		printf("\n%s\n", name);
+
+		SkipList<int> list(0.5, 32, backLinks);
+
+		list.seed(3);
+
+		long long before = allocations, bytes = allocated;
+
+		double ms = bench::best(1, [&]()
+		{
+			for (int key : keys)
+			{
+				list.insert(key);
+			}
+		});
+
+		snprintf(label, sizeof(label), "insert %d keys", size);
+		row(label, ms, size);
+		printf("  %.2f allocations and %.1f bytes per key\n",
+				(double)(allocations - before) / size, (double)(allocated - bytes) / size);
+
+		int found = 0, expected = 0;
+
+		for (int key : queries)
+		{
+			expected += key % 2 == 0;
+		}
+
+		ms = bench::best(3, [&]() { found = 0; }, [&]()
+		{
+			for (int key : queries)
+			{
+				found += list.find(key) != nullptr;
+			}
+		});
+
+		bench::check(found == expected, "wrong number of keys found");
+		bench::check(list.find(-1) == nullptr, "found a key below all the keys");
+		row("find", ms, count);
+
+		long long ranks = 0;
+
+		ms = bench::best(3, [&]() { ranks = 0; }, [&]()
+		{
+			for (int key : queries)
+			{
+				ranks += list.rank(key);
+			}
+		});
+
+		bench::keep(ranks);
+		row("rank", ms, count);
+	}
+}
+
+void* operator new(size_t size)
+{
+	allocations++;
+	allocated += size;
+
+	void* block = malloc(size ? size : 1);
+
+	if (!block)
+	{
+		throw std::bad_alloc();
+	}
+
+	return block;
+}
+
+void operator delete(void* block) noexcept
+{
+	free(block);
+}
+
+int main(int argc, char** argv)
+{
+	int size = (int)bench::argument(argc, argv, 1, 1000000);
+	int count = (int)bench::argument(argc, argv, 2, 200000);
+
+	std::vector<int> keys(size), queries(count);
+	std::mt19937 random(9);
+
+	for (int i = 0; i < size; i++)
+	{
+		keys[i] = 2 * i;
+	}
+
+	std::shuffle(keys.begin(), keys.end(), random);
+
+	for (int i = 0; i < count; i++)
+	{
+		queries[i] = (int)(random() % (2 * size));
+	}
+
+	printf("%d random keys, %d random queries (about half of them are found)\n", size, count);
+
+	run("without back links (the default)", false, keys, queries);
+	run("with back links", true, keys, queries);
+
+	return 0;
+}
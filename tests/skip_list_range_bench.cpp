@@ -0,0 +1,133 @@
+/**
+ * SkipList: range queries, against repeated successor calls (each one a search from the head).
+ * The list holds the even numbers below 2n, and each case sums the keys of random ranges of a
+ * given length: by successor calls, by an iterator from lowerBound, and by rangeScan. The last
+ * row counts the keys of the ranges with rangeCount, without visiting them.
+ * Usage: ./skip_list_range_bench [size] [keys visited per case]
+ */
+
+#include "bench.h"
+#include "lists/skip_list/SkipList.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+	void row(const char* name, double ms, long long keys, double baseline = 0)
+	{
+		printf("  %-30s %10.2f ms %8.1f ns/key", name, ms, 1000000 * ms / keys);
+
+		if (baseline > 0)
+		{
+			printf("  %8.2fx", baseline / ms);
+		}
+
+		printf("\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int size = (int)bench::argument(argc, argv, 1, 1000000);
+	long long visits = bench::argument(argc, argv, 2, 2000000);
+	const int lengths[] = { 10, 1000, 100000 };
+
+	std::vector<int> keys(size);
+
+	for (int i = 0; i < size; i++)
+	{
+		keys[i] = 2 * i;
+	}
+
+	SkipList<int> list;
+
+	list.buildFromSorted(keys.data(), size);
+
+	printf("%d keys\n", size);
+
+	for (int length : lengths)
+	{
+		if (length > size)
+		{
+			break;
+		}
+
+		// each range holds length keys, and the cases visit about the same number of keys
+		int ranges = (int)(visits / length > 0 ? visits / length : 1);
+		std::vector<int> starts(ranges);
+		std::mt19937 random(length);
+
+		for (int i = 0; i < ranges; i++)
+		{
+			starts[i] = 2 * (int)(random() % (size - length + 1));
+		}
+
+		long long expected = 0, sum = 0, count = (long long)ranges * length;
+
+		for (int lo : starts)
+		{
+			expected += (long long)length * lo + (long long)length * (length - 1);
+		}
+
+		printf("\n%d ranges of %d keys\n", ranges, length);
+
+		double successor = bench::best(1, [&]() { sum = 0; }, [&]()
+		{
+			for (int lo : starts)
+			{
+				int hi = lo + 2 * (length - 1), key = lo;
+
+				sum += key;
+
+				while (key < hi)
+				{
+					key = list.successor(key);
+					sum += key;
+				}
+			}
+		});
+
+		bench::check(sum == expected, "wrong sum of the successor calls");
+		row("successor calls", successor, count);
+
+		double ms = bench::best(3, [&]() { sum = 0; }, [&]()
+		{
+			for (int lo : starts)
+			{
+				int hi = lo + 2 * (length - 1);
+
+				for (SkipList<int>::Iterator it = list.lowerBound(lo); it != list.end() && *it <= hi; ++it)
+				{
+					sum += *it;
+				}
+			}
+		});
+
+		bench::check(sum == expected, "wrong sum of the iterator");
+		row("lowerBound + iterator", ms, count, successor);
+
+		ms = bench::best(3, [&]() { sum = 0; }, [&]()
+		{
+			for (int lo : starts)
+			{
+				list.rangeScan(lo, lo + 2 * (length - 1), [&](int key) { sum += key; });
+			}
+		});
+
+		bench::check(sum == expected, "wrong sum of rangeScan");
+		row("rangeScan", ms, count, successor);
+
+		ms = bench::best(3, [&]() { sum = 0; }, [&]()
+		{
+			for (int lo : starts)
+			{
+				sum += list.rangeCount(lo, lo + 2 * (length - 1));
+			}
+		});
+
+		bench::check(sum == count, "wrong rangeCount");
+		row("rangeCount (no visits)", ms, count, successor);
+	}
+
+	return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * A test of the Sort algorithms that take a comparator, on a record type with no operator<.
+ * The code paths that only apply to the natural order of numbers (the SimdSort kernels, which
+ * compare with operator<) must not be compiled for such a type, so this test is first of all a
+ * compile test. It also checks that the records are sorted, that mergeSort is stable, and that
+ * ints still sort in both orders.
+ * Build and run with "make sort-test".
+ */
+
+#include "Sort.h"
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace
+{
+	/** A record ordered by its key only, it has no operator<. */
+	struct Record
+	{
+		int key;
+		int id;
+	};
+
+	struct ByKey
+	{
+		bool operator()(const Record& a, const Record& b) const
+		{
+			return a.key < b.key;
+		}
+	};
+
+	void check(bool condition, const char* message)
+	{
+		if (!condition)
+		{
+			fprintf(stderr, "FAILED: %s\n", message);
+			exit(1);
+		}
+	}
+
+	std::vector<Record> records(int size, int distinct)
+	{
+		std::mt19937 random(size);
+		std::vector<Record> result(size);
+
+		for (int i = 0; i < size; i++)
+		{
+			result[i].key = (int)(random() % distinct);
+			result[i].id = i;
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief check that the records are sorted by key, and by id within a key if stable.
+	 */
+	void checkSorted(const std::vector<Record>& arr, bool stable, const char* message)
+	{
+		for (int i = 1; i < (int)arr.size(); i++)
+		{
+			check(arr[i - 1].key <= arr[i].key, message);
+			check(!stable || arr[i - 1].key < arr[i].key || arr[i - 1].id < arr[i].id, message);
+		}
+	}
+}
+
+int main()
+{
+	const int sizes[] = { 0, 1, 2, 30, 65, 1000, 200000 };
+
+	for (int size : sizes)
+	{
+		std::vector<Record> arr = records(size, size / 4 + 1);
+		Sort<Record>::quickSort(arr.data(), size, ByKey());
+		checkSorted(arr, false, "quickSort did not sort the records");
+
+		arr = records(size, size / 4 + 1);
+		Sort<Record>::parallelSort(arr.data(), size, 4, ByKey());
+		checkSorted(arr, false, "parallelSort did not sort the records");
+
+		arr = records(size, size / 4 + 1);
+		Sort<Record>::mergeSort(arr.data(), size, ByKey());
+		checkSorted(arr, true, "mergeSort did not sort the records stably");
+
+		arr = records(size, size / 4 + 1);
+		Sort<Record>::radixSort(arr.data(), size, [](const Record& r) { return r.key; });
+		checkSorted(arr, true, "radixSort did not sort the records stably");
+
+		// ints go through the SimdSort kernels when the CPU has AVX2, and not in descending order
+		std::vector<int> ints(size);
+
+		for (int i = 0; i < size; i++)
+		{
+			ints[i] = arr[(i * 7919) % size].key - size / 8;
+		}
+
+		std::vector<int> descending(ints);
+
+		Sort<int>::quickSort(ints.data(), size);
+		Sort<int>::quickSort(descending.data(), size, std::greater<int>());
+
+		for (int i = 1; i < size; i++)
+		{
+			check(ints[i - 1] <= ints[i], "quickSort did not sort the ints");
+			check(descending[i - 1] >= descending[i], "quickSort did not sort the ints in descending order");
+		}
+	}
+
+	printf("ok\n");
+
+	return 0;
+}
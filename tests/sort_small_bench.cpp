@@ -0,0 +1,101 @@
+/**
+ * Sort::sortSmall (the AVX2 kernels of SimdSort for 32 bit keys) against Sort::insertionSort
+ * and std::sort on small arrays of 8 to 4096 ints and floats, and on 64 bit ints, which have no
+ * kernel and are insertion-sorted either way.
+ * Each size sorts many random arrays, about the same number of keys in total, and the time is
+ * per key; the copying of the arrays is timed alone and taken off. All the results are checked.
+ * Usage: ./sort_small_bench [keys per size]
+ */
+
+#include "bench.h"
+#include "SimdSort.h"
+#include "Sort.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief the time in ns per key of sorting all the arrays of a size, copied from the keys.
+	 */
+	template<typename T, typename Sorter>
+	double measure(const std::vector<T>& keys, const std::vector<T>& expected, int size, const char* name, Sorter sorter)
+	{
+		int count = (int)keys.size() / size;
+		std::vector<T> arr(keys.size());
+
+		double copying = bench::best(3, [&]()
+		{
+			for (int a = 0; a < count; a++)
+			{
+				memcpy(&arr[(size_t)a * size], &keys[(size_t)a * size], size * sizeof(T));
+			}
+		});
+
+		double ms = bench::best(3, [&]()
+		{
+			for (int a = 0; a < count; a++)
+			{
+				memcpy(&arr[(size_t)a * size], &keys[(size_t)a * size], size * sizeof(T));
+				sorter(&arr[(size_t)a * size], size);
+			}
+		});
+
+		bench::check(std::equal(expected.begin(), expected.begin() + (size_t)count * size, arr.begin()), name);
+
+		return std::max(ms - copying, 0.0) * 1000000 / ((double)count * size);
+	}
+
+	template<typename T>
+	void run(const char* type, int total)
+	{
+		std::mt19937_64 random(1);
+
+		printf("\n  %s (ns per key)\n  %6s %14s %14s %14s\n", type, "size", "insertionSort", "std::sort", "sortSmall");
+
+		for (int size = 8; size <= 4096; size *= 2)
+		{
+			int count = std::max(total / size, 1);
+			std::vector<T> keys((size_t)count * size);
+
+			for (T& key : keys)
+			{
+				key = (T)(int64_t)random();
+			}
+
+			std::vector<T> expected(keys);
+
+			for (int a = 0; a < count; a++)
+			{
+				std::sort(expected.begin() + (size_t)a * size, expected.begin() + (size_t)(a + 1) * size);
+			}
+
+			// insertion sort is quadratic, it gets a quarter of the keys from 1024 up
+			std::vector<T> fewer(keys.begin(), keys.begin() + (size_t)(size >= 1024 ? std::max(count / 4, 1) : count) * size);
+
+			double insertion = measure(fewer, expected, size, "insertionSort",
+					[](T* arr, int n) { Sort<T>::insertionSort(arr, n); });
+			double stl = measure(keys, expected, size, "std::sort", [](T* arr, int n) { std::sort(arr, arr + n); });
+			double small = measure(keys, expected, size, "sortSmall", [](T* arr, int n) { Sort<T>::sortSmall(arr, n); });
+
+			printf("  %6d %14.2f %14.2f %14.2f  %6.2fx\n", size, insertion, stl, small, insertion / small);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int total = (int)bench::argument(argc, argv, 1, 1 << 20);
+
+	printf("%d keys per size, AVX2 %s (the speedup is over insertionSort)\n", total,
+			SimdSort::supported() ? "supported" : "not supported, sortSmall is an insertion sort");
+
+	run<int32_t>("int32", total);
+	run<float>("float", total);
+	run<int64_t>("int64 (no kernel)", total);
+
+	return 0;
+}
@@ -0,0 +1,147 @@
+/**
+ * StaticSortedArray: searches on read-only sorted keys, against a binary search on a sorted
+ * array (std::lower_bound), BST, AVLTree and SkipList.
+ * The keys are the even numbers below 2n in random order, and the queries are random numbers
+ * below 2n, so about half of them are found. The sizes grow by 10 from 1K up to a maximum.
+ * Usage: ./static_sorted_array_bench [maximum size] [queries]
+ */
+
+#include "bench.h"
+#include "lists/StaticSortedArray.h"
+#include "lists/skip_list/SkipList.h"
+#include "trees/AVLTree.h"
+#include "trees/BST.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+	void row(const char* name, double ms, int queries)
+	{
+		printf("  %-38s %10.2f ms %10.1f ns/query\n", name, ms, 1000000 * ms / queries);
+	}
+
+	/**
+	 * @brief time the queries through a search that tells if a key is found, and check the number of
+	 * keys found.
+	 */
+	template<typename F>
+	void measure(const char* name, const std::vector<int>& queries, int expected, F found)
+	{
+		int count = 0;
+
+		double ms = bench::best(3, [&]() { count = 0; }, [&]()
+		{
+			for (int key : queries)
+			{
+				count += found(key);
+			}
+		});
+
+		bench::check(count == expected, name);
+		row(name, ms, (int)queries.size());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int maximum = (int)bench::argument(argc, argv, 1, 1000000);
+	int count = (int)bench::argument(argc, argv, 2, 1000000);
+
+	for (int size = 1000; size <= maximum; size *= 10)
+	{
+		std::mt19937 random(size);
+		std::vector<int> keys(size), sorted(size), queries(count);
+
+		for (int i = 0; i < size; i++)
+		{
+			sorted[i] = 2 * i;
+		}
+
+		keys = sorted;
+		std::shuffle(keys.begin(), keys.end(), random);
+
+		for (int i = 0; i < count; i++)
+		{
+			queries[i] = (int)(random() % (2 * size));
+		}
+
+		int expected = 0;
+
+		for (int key : queries)
+		{
+			expected += key % 2 == 0;
+		}
+
+		printf("\n%d keys, %d queries\n", size, count);
+
+		measure("binary search (std::lower_bound)", queries, expected, [&](int key)
+		{
+			std::vector<int>::const_iterator it = std::lower_bound(sorted.begin(), sorted.end(), key);
+
+			return it != sorted.end() && *it == key;
+		});
+
+		{
+			StaticSortedArray<int> array(keys.data(), size);
+
+			measure("StaticSortedArray contains", queries, expected, [&](int key)
+			{
+				return array.contains(key);
+			});
+
+			measure("StaticSortedArray lowerBound", queries, expected, [&](int key)
+			{
+				int rank = array.lowerBound(key);
+
+				return rank < size && sorted[rank] == key;
+			});
+
+			std::vector<int> ranks(count);
+
+			double ms = bench::best(3, [&]() { array.lowerBounds(queries.data(), ranks.data(), count); });
+			int found = 0;
+
+			for (int i = 0; i < count; i++)
+			{
+				found += ranks[i] < size && sorted[ranks[i]] == queries[i];
+			}
+
+			bench::check(found == expected, "StaticSortedArray lowerBounds");
+			row("StaticSortedArray lowerBounds (batch)", ms, count);
+		}
+
+		{
+			BST<int> tree;
+
+			for (int key : keys)
+			{
+				tree.insert(key);
+			}
+
+			measure("BST search", queries, expected, [&](int key) { return tree.search(key) != nullptr; });
+		}
+
+		{
+			AVLTree<int> tree;
+
+			for (int key : keys)
+			{
+				tree.insert(key);
+			}
+
+			measure("AVLTree search", queries, expected, [&](int key) { return tree.search(key) != nullptr; });
+		}
+
+		{
+			SkipList<int> list;
+
+			list.buildFromSorted(sorted.data(), size);
+
+			measure("SkipList find", queries, expected, [&](int key) { return list.find(key) != nullptr; });
+		}
+	}
+
+	return 0;
+}
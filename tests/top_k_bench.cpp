@@ -0,0 +1,153 @@
+/**
+ * TopK: the K largest keys of a long stream, against sorting the whole stream.
+ * The full sorts are MaxHeap::heapSort of a copy of the stream (then the last K keys), and a
+ * MaxHeap built from the stream and popped K times (what taking the top K took before TopK).
+ * TopK takes the stream one key at a time (push), in batches (pushMany), and split among
+ * threads whose selections are then merged (mergeAll). All of them must give the same keys.
+ * Usage: ./top_k_bench [stream size] [threads]
+ */
+
+#include "bench.h"
+#include "heaps/MaxHeap.h"
+#include "heaps/TopK.h"
+#include "lists/DynamicArray.h"
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	const int BATCH = 4096;     // the keys given to one pushMany
+
+	/**
+	 * @brief check that the keys found are the K largest keys, from the largest down.
+	 */
+	void verify(const DynamicArray<int>& found, const std::vector<int>& expected, const char* name)
+	{
+		bool same = found.size() == (int)expected.size();
+
+		for (int i = 0; same && i < found.size(); i++)
+		{
+			same = found.get(i) == expected[i];
+		}
+
+		bench::check(same, name);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	long long n = bench::argument(argc, argv, 1, 10000000);
+	int threads = (int)bench::argument(argc, argv, 2, std::max((int)std::thread::hardware_concurrency(), 4));
+
+	std::mt19937 random(1);
+	DynamicArray<int> stream((int)n);
+
+	for (long long i = 0; i < n; i++)
+	{
+		stream.add((int)(random() >> 1));
+	}
+
+	printf("a stream of %lld random keys, %d threads for the parallel selection\n", n, threads);
+
+	DynamicArray<int> sorted(stream);
+
+	double sortMs = bench::best(1, [&]() { MaxHeap<int>::heapSort(sorted); });
+
+	for (int k : { 10, 1000, 100000 })
+	{
+		std::vector<int> expected;
+
+		for (int i = 0; i < k; i++)
+		{
+			expected.push_back(sorted.get((int)n - 1 - i));
+		}
+
+		printf("\nK = %d\n", k);
+		bench::row("MaxHeap::heapSort of a copy", sortMs);
+
+		double full = bench::best(1, [&]()
+		{
+			MaxHeap<int> heap(stream);
+			DynamicArray<int> found(k);
+
+			for (int i = 0; i < k; i++)
+			{
+				found.add(heap.extractMax());
+			}
+
+			verify(found, expected, "MaxHeap found other keys");
+		});
+
+		bench::row("MaxHeap of the stream, k extractMax", full);
+
+		double ms = bench::best(1, [&]()
+		{
+			TopK<int> top(k);
+
+			for (int i = 0; i < (int)n; i++)
+			{
+				top.push(stream.get(i));
+			}
+
+			verify(top.result(), expected, "TopK::push found other keys");
+		});
+
+		bench::row("TopK::push", ms, full);
+
+		ms = bench::best(1, [&]()
+		{
+			TopK<int> top(k);
+
+			for (int i = 0; i < (int)n; i += BATCH)
+			{
+				top.pushMany(&stream[i], std::min(BATCH, (int)n - i));
+			}
+
+			verify(top.result(), expected, "TopK::pushMany found other keys");
+		});
+
+		bench::row("TopK::pushMany", ms, full);
+
+		ms = bench::best(1, [&]()
+		{
+			std::vector<TopK<int>*> parts;
+			std::vector<std::thread> workers;
+			int share = (int)((n + threads - 1) / threads);
+
+			for (int t = 0; t < threads; t++)
+			{
+				parts.push_back(new TopK<int>(k));
+			}
+
+			for (int t = 0; t < threads; t++)
+			{
+				workers.push_back(std::thread([&, t]()
+				{
+					for (int i = t * share, end = (int)std::min(n, (long long)(t + 1) * share); i < end; i += BATCH)
+					{
+						parts[t]->pushMany(&stream[i], std::min(BATCH, end - i));
+					}
+				}));
+			}
+
+			for (std::thread& worker : workers)
+			{
+				worker.join();
+			}
+
+			TopK<int>::mergeAll(parts.data(), threads);
+			verify(parts[0]->result(), expected, "the merged TopK found other keys");
+
+			for (TopK<int>* part : parts)
+			{
+				delete part;
+			}
+		});
+
+		bench::row("TopK::pushMany per thread + mergeAll", ms, full);
+	}
+
+	return 0;
+}